@@ -0,0 +1,109 @@
+// Microbenchmark de los locks de la OSAL (build de PC, no entra en el firmware).
+//
+// Mide ns por sección crítica vacía y con la forma de una lectura del
+// AlmacenFlexible (find en un std::map bajo el lock del mapa), sin contención y
+// con dos hilos. Sirve para decidir qué lock usar en cada sitio; los números del
+// cambio de AlmacenFlexible a Mutex salen de aquí.
+//
+//   g++ -O2 -std=c++17 -Ilib/Core/include -Ilib/PlatformWin/include bench/locks_bench.cpp -o locks_bench
+//
+// Con -DFP_ENABLE_CONTENTION_STATS los TrackedLock incluyen el coste de las sondas.
+
+#include "FlightProxy/Core/OSAL/Locks.h"
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+using namespace FlightProxy::Core::OSAL;
+
+namespace
+{
+    constexpr int kIterations = 5000000;
+    constexpr int kContendedIterations = kIterations / 5;
+
+    volatile int sink = 0;
+
+    template <typename F>
+    double nsPerOp(F &&op, int iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            op();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    }
+
+    // Dos hilos haciendo la misma operación a la vez; ns por operación total
+    template <typename F>
+    double nsPerOpContended(F &&op)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::thread other([&op]()
+                          {
+                              for (int i = 0; i < kContendedIterations; ++i)
+                                  op();
+                          });
+        for (int i = 0; i < kContendedIterations; ++i)
+            op();
+        other.join();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (2 * kContendedIterations);
+    }
+
+    // Lectura del mapa del almacén: lock, find, unlock
+    template <typename Guard, typename Lock>
+    void mapLookup(Lock &lock, const std::map<uint32_t, std::shared_ptr<int>> &storage)
+    {
+        Guard guard(lock);
+        auto it = storage.find(10);
+        if (it != storage.end())
+            sink = sink + 1;
+    }
+
+    template <typename Guard, typename Lock>
+    void report(const char *name, Lock &lock, const std::map<uint32_t, std::shared_ptr<int>> &storage)
+    {
+        auto empty = [&lock]()
+        {
+            Guard guard(lock);
+            sink = sink + 1;
+        };
+        auto lookup = [&lock, &storage]()
+        { mapLookup<Guard>(lock, storage); };
+
+        std::printf("%-34s %7.1f %9.1f %11.1f\n", name,
+                    nsPerOp(empty, kIterations),
+                    nsPerOp(lookup, kIterations),
+                    nsPerOpContended(lookup));
+    }
+}
+
+int main()
+{
+    std::map<uint32_t, std::shared_ptr<int>> storage;
+    for (uint32_t id : {0u, 1u, 10u})
+        storage[id] = std::make_shared<int>(0);
+
+    auto recursive = Factory::createMutex("bench");
+    Mutex mutex;
+    SpinLock spin;
+    SharedMutex shared;
+    TrackedLock<Mutex> trackedMutex{"bench.mutex"};
+    TrackedLock<SharedMutex> trackedShared{"bench.shared"};
+
+    std::printf("%-34s %7s %9s %11s\n", "lock (ns/op)", "vacío", "map find", "2 hilos");
+    report<std::lock_guard<IMutex>>("IMutex (recursivo, virtual)", *recursive, storage);
+    report<std::lock_guard<Mutex>>("Mutex", mutex, storage);
+    report<std::lock_guard<SpinLock>>("SpinLock", spin, storage);
+    report<std::shared_lock<SharedMutex>>("SharedMutex (lectura)", shared, storage);
+    report<std::lock_guard<SharedMutex>>("SharedMutex (escritura)", shared, storage);
+    report<std::lock_guard<TrackedLock<Mutex>>>("TrackedLock<Mutex>", trackedMutex, storage);
+    report<std::shared_lock<TrackedLock<SharedMutex>>>("TrackedLock<SharedMutex> (lectura)", trackedShared, storage);
+    return 0;
+}
@@ -1,5 +1,5 @@
 #pragma once
-#include "FlightProxy/Core/OSAL/OSALFactory.h" // Para el Mutex
+#include "FlightProxy/Core/OSAL/Locks.h" // Para el Mutex
 
 #include <mutex>      // Para std::lock_guard
 #include <map>        // Para el almacén de "cajones"
@@ -31,6 +31,12 @@ namespace FlightProxy
         {
 
         private:
+            // Con FP_ENABLE_CONTENTION_STATS miden espera y tiempo dentro; si no, son los locks tal cual
+            using SlotMutex = Core::OSAL::TrackedLock<Core::OSAL::Mutex>;
+            // El mapa solo se lee un instante (find): un Mutex simple sale más barato que el
+            // reparto lectores/escritor de SharedMutex (ver bench/locks_bench.cpp)
+            using MapMutex = Core::OSAL::TrackedLock<Core::OSAL::Mutex>;
+
             /**
              * @struct SlotBase
              * @brief Interfaz base NO tipada.
@@ -39,12 +45,12 @@ namespace FlightProxy
              */
             struct SlotBase
             {
-                std::unique_ptr<Core::OSAL::IMutex> slotMutex;
+                SlotMutex slotMutex{"Almacen.slot"}; // No recursivo: solo protege copias del dato
 
                 std::chrono::steady_clock::time_point last_update;
                 double frequency_hz = 0.0;
 
-                SlotBase() : slotMutex(Core::OSAL::Factory::createMutex()) {}
+                SlotBase() = default;
                 virtual ~SlotBase() = default;
 
                 // Método virtual para consultar el tipo real almacenado sin usar typeid
@@ -93,7 +99,7 @@ namespace FlightProxy
 
             // Mapa de IDs a punteros BASE (polimorfismo)
             std::map<DataID, std::shared_ptr<SlotBase>> m_storage;
-            std::unique_ptr<Core::OSAL::IMutex> m_mapMutex;
+            MapMutex m_mapMutex{"Almacen.map"}; // Casi solo lecturas: los cajones se crean al arrancar
 
             /**
              * @brief Obtiene o crea un cajón tipado de forma segura.
@@ -101,20 +107,13 @@ namespace FlightProxy
             template <typename T>
             std::shared_ptr<TypedSlot<T>> getOrCreateSlot(DataID id)
             {
-                std::lock_guard<Core::OSAL::IMutex> lock(*m_mapMutex);
+                std::lock_guard<MapMutex> lock(m_mapMutex);
 
                 auto it = m_storage.find(id);
                 if (it != m_storage.end())
                 {
-                    // --- EL CAJÓN YA EXISTE ---
-                    // Validamos que el tipo solicitado (T) coincida con el tipo creado originalmente.
-                    if (it->second->getActualTypeID() != getTypeID<T>())
-                    {
-                        throw std::runtime_error("Error de tipo (No-RTTI) en DataID: " + std::to_string(id));
-                    }
-
-                    // Static cast es seguro aquí porque acabamos de validar el ID del tipo.
-                    return std::static_pointer_cast<TypedSlot<T>>(it->second);
+                    // --- EL CAJÓN YA EXISTE --- (camino habitual)
+                    return checkedCast<T>(it->second, id);
                 }
                 else
                 {
@@ -125,8 +124,21 @@ namespace FlightProxy
                 }
             }
 
+            template <typename T>
+            static std::shared_ptr<TypedSlot<T>> checkedCast(const std::shared_ptr<SlotBase> &slot, DataID id)
+            {
+                // Validamos que el tipo solicitado (T) coincida con el tipo creado originalmente.
+                if (slot->getActualTypeID() != getTypeID<T>())
+                {
+                    throw std::runtime_error("Error de tipo (No-RTTI) en DataID: " + std::to_string(id));
+                }
+
+                // Static cast es seguro aquí porque acabamos de validar el ID del tipo.
+                return std::static_pointer_cast<TypedSlot<T>>(slot);
+            }
+
         public:
-            AlmacenFlexible() : m_mapMutex(Core::OSAL::Factory::createMutex()) {}
+            AlmacenFlexible() = default;
             ~AlmacenFlexible() = default;
 
             // En la sección public de AlmacenFlexible:
@@ -137,14 +149,14 @@ namespace FlightProxy
              */
             double getFrequency(DataID id)
             {
-                std::lock_guard<Core::OSAL::IMutex> mapLock(*m_mapMutex);
+                std::lock_guard<MapMutex> mapLock(m_mapMutex);
                 auto it = m_storage.find(id);
                 if (it == m_storage.end())
                 {
                     return 0.0;
                 }
 
-                std::lock_guard<Core::OSAL::IMutex> slotLock(*(it->second->slotMutex));
+                std::lock_guard<SlotMutex> slotLock(it->second->slotMutex);
 
                 // 1. Si nunca se ha actualizado o solo una vez (no hay periodo aún), devolvemos 0 o la inicial.
                 if (it->second->frequency_hz <= 0.0 || it->second->last_update.time_since_epoch().count() == 0)
@@ -183,7 +195,7 @@ namespace FlightProxy
                 return [slot](T newData)
                 {
                     // Bloqueo granular usando el mutex del slot.
-                    std::lock_guard<Core::OSAL::IMutex> lock(*(slot->slotMutex));
+                    std::lock_guard<SlotMutex> lock(slot->slotMutex);
                     slot->data = std::move(newData);
                     slot->updateStats();
                 };
@@ -196,7 +208,7 @@ namespace FlightProxy
 
                 return [slot]() -> T
                 {
-                    std::lock_guard<Core::OSAL::IMutex> lock(*(slot->slotMutex));
+                    std::lock_guard<SlotMutex> lock(slot->slotMutex);
                     return slot->data;
                 };
             }
@@ -2,10 +2,21 @@
 
 #include "FlightProxy/Core/FlightProxyTypes.h"
 #include "FlightProxy/AppLogic/Command/ICommand.h"
+#include "FlightProxy/AppLogic/Command/OverloadPolicy.h"
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+#include "FlightProxy/Core/OSAL/IExecutor.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+#include "FlightProxy/Core/Utils/MpmcQueue.h"
+#include "FlightProxy/Core/Utils/Profiler.h"
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace FlightProxy
 {
@@ -13,6 +24,21 @@ namespace FlightProxy
     {
         namespace Command
         {
+            struct CommandManagerConfig
+            {
+                size_t queueDepth = 16;  // Profundidad de la cola de cada worker (se redondea a potencia de 2)
+                size_t workerCount = 2;  // Número de tareas que procesan comandos
+                uint32_t stackSize = 4096;
+                int priority = 2;
+                int coreId = -1;
+
+                size_t maxInFlight = 16;         // Comandos pendientes de respuesta a la vez
+                uint32_t defaultTimeoutMs = 1000; // Timeout si el comando no define el suyo
+                uint32_t sweepPeriodMs = 100;     // Cada cuánto se revisan los timeouts sin temporizador
+
+                OverloadPolicy overload;
+            };
+
             template <typename PacketT>
             class CommandManager : public std::enable_shared_from_this<CommandManager<PacketT>>
             {
@@ -20,28 +46,189 @@ namespace FlightProxy
                 using SenderFunc = std::function<bool(uint32_t, std::unique_ptr<const PacketT> packet)>;
                 SenderFunc responsehandler;
 
-                CommandManager(size_t queueSize = 5)
+                // Opcional: construye la respuesta de error (timeout o saturación) para un comando.
+                // Si no se define, la petición se descarta sin responder.
+                using ErrorReplyFactory = std::function<std::unique_ptr<const PacketT>(int commandId)>;
+                ErrorReplyFactory errorReplyFactory;
+
+                CommandManager(const CommandManagerConfig &config = CommandManagerConfig())
+                    : config_(config), async_(std::make_shared<AsyncState>())
                 {
-                    packetQueue_ = Core::OSAL::Factory::createQueue<Core::PacketEnvelope<PacketT>>(queueSize);
+                    if (config_.workerCount == 0)
+                        config_.workerCount = 1;
+                    config_.overload.normalize();
+
+                    for (size_t i = 0; i < config_.workerCount; ++i)
+                    {
+                        bool hasPriority = !config_.overload.priorityCommands.empty();
+                        auto queue = std::make_unique<EnvelopeQueue>(config_.queueDepth);
+                        auto worker = std::make_unique<Worker>(queue->capacity() * (hasPriority ? 2 : 1));
+                        worker->queue = std::move(queue);
+                        if (hasPriority)
+                        {
+                            worker->priorityQueue = std::make_unique<EnvelopeQueue>(config_.queueDepth);
+                        }
+                        // "Timbre" (flag de eventos): solo sirve para despertar al worker,
+                        // los datos viajan por la cola lock-free.
+                        worker->doorbell = Core::OSAL::Factory::createEventFlags();
+                        workers_.push_back(std::move(worker));
+                    }
                 }
 
                 ~CommandManager()
                 {
                     stop();
+
+                    // Las respuestas que lleguen tarde ya no tienen a quién entregarse
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                        async_->sender = nullptr;
+                        async_->errorFactory = nullptr;
+                        if (timers_)
+                        {
+                            for (const auto &p : async_->inFlight)
+                                timers_->cancel(p->timerId.load());
+                        }
+                        async_->inFlight.clear();
+                    }
+
+                    // Los paquetes que quedaron en las colas se liberan con ellas
                 }
 
                 // Método público para recibir paquetes desde CUALQUIER sitio (Agregador incluido)
-                bool enqueuePacket(const Core::PacketEnvelope<PacketT> &envelope)
+                // Es lock-free y seguro desde varias tareas a la vez.
+                // Si lo acepta se queda con el paquete del sobre; si devuelve false el
+                // paquete sigue en el sobre (del llamador).
+                bool enqueuePacket(Core::PacketEnvelope<PacketT> &envelope)
                 {
-                    if (!packetQueue_)
+                    if (!envelope.packet)
+                        return false;
+
+                    const OverloadPolicy &policy = config_.overload;
+
+                    // Shard por canal: todos los paquetes de un cliente van al mismo
+                    // worker, así se conserva su orden.
+                    Worker &worker = *workers_[envelope.channelId % workers_.size()];
+
+                    envelope.enqueuedAtMs = Core::OSAL::Factory::getSystemTimeMs();
+
+                    bool priority = worker.priorityQueue && policy.isPriority(envelope.packet->command);
+                    EnvelopeQueue &queue = priority ? *worker.priorityQueue : *worker.queue;
+
+                    // Cuota por cliente (los comandos prioritarios no cuentan). El
+                    // contador va en la entrada del cliente que trae el sobre.
+                    std::shared_ptr<Core::ClientCounters> client = envelope.client;
+                    std::atomic<uint32_t> *quota = nullptr;
+                    if (!priority && policy.perClientQuota > 0 && client)
+                    {
+                        quota = &client->queued;
+                        if (quota->fetch_add(1) >= policy.perClientQuota)
+                        {
+                            quota->fetch_sub(1);
+                            stats_.quotaRejected++;
+                            return false;
+                        }
+                    }
+
+                    // Si la cola está llena tryPush no consume el sobre
+                    bool pushed = queue.tryPush(std::move(envelope));
+                    if (!pushed && policy.dropOldest)
+                    {
+                        // La cola admite varios consumidores: expulsamos el más antiguo desde aquí
+                        Core::PacketEnvelope<PacketT> oldest;
+                        if (queue.tryPop(oldest))
+                        {
+                            discard(oldest, !priority);
+                            stats_.droppedOldest++;
+                            worker.probe.dropped(1);
+                        }
+                        pushed = queue.tryPush(std::move(envelope));
+                    }
+
+                    if (!pushed)
+                    {
+                        if (quota)
+                            quota->fetch_sub(1);
+                        stats_.droppedNewest++;
+                        worker.probe.sendFailed(0);
                         return false;
+                    }
 
-                    return packetQueue_->send(Core::PacketEnvelope<PacketT>(envelope), 0);
+                    worker.probe.sent(1, 0);
+                    stats_.accepted++;
+                    if (priority)
+                        stats_.acceptedPriority++;
+
+                    if (executor_)
+                    {
+                        schedule(worker);
+                    }
+                    else
+                    {
+                        // Si el timbre ya está pendiente no pasa nada: el worker vaciará la cola entera.
+                        worker.doorbell->set(kDoorbell);
+                    }
+                    return true;
                 }
 
+                // Registrar antes de start(): la tabla se lee sin locks desde los workers.
                 void registerCommand(std::shared_ptr<ICommand<PacketT>> command)
                 {
-                    commandMap_[command->getID()] = command;
+                    if (isRunning_)
+                    {
+                        FP_LOG_W("CommandManager", "registerCommand ignorado: el manager ya está en marcha");
+                        return;
+                    }
+
+                    int id = command->getID();
+                    auto it = std::lower_bound(commandTable_.begin(), commandTable_.end(), id,
+                                               [](const CommandEntry &entry, int key)
+                                               { return entry.first < key; });
+                    if (it != commandTable_.end() && it->first == id)
+                    {
+                        it->second = command;
+                    }
+                    else
+                    {
+                        commandTable_.insert(it, CommandEntry(id, command));
+                    }
+                }
+
+                // Con un TimerService cada petición lleva su propio temporizador de timeout
+                // (O(1) al responder) en vez del barrido periódico de la lista en vuelo.
+                // Asignar antes de start().
+                void setTimerService(std::shared_ptr<Core::OSAL::TimerService> timers)
+                {
+                    if (isRunning_)
+                    {
+                        FP_LOG_W("CommandManager", "setTimerService ignorado: el manager ya está en marcha");
+                        return;
+                    }
+                    timers_ = std::move(timers);
+                }
+
+                // Con un executor los comandos se procesan en sus workers en vez de en
+                // tareas propias (workerCount pasa a ser el número de shards por canal).
+                // Asignar antes de start(); debe seguir en marcha hasta después de stop().
+                void setExecutor(std::shared_ptr<Core::OSAL::IExecutor> executor)
+                {
+                    if (isRunning_)
+                    {
+                        FP_LOG_W("CommandManager", "setExecutor ignorado: el manager ya está en marcha");
+                        return;
+                    }
+                    executor_ = std::move(executor);
+                }
+
+                // Comando que atiende los IDs sin comando registrado (p. ej. un passthrough a la FC)
+                void setFallbackCommand(std::shared_ptr<ICommand<PacketT>> command)
+                {
+                    if (isRunning_)
+                    {
+                        FP_LOG_W("CommandManager", "setFallbackCommand ignorado: el manager ya está en marcha");
+                        return;
+                    }
+                    fallbackCommand_ = std::move(command);
                 }
 
                 void start()
@@ -49,94 +236,394 @@ namespace FlightProxy
                     if (isRunning_)
                         return;
 
-                    // 2. Configurar y crear la tarea
-                    Core::OSAL::TaskConfig config;
-                    config.name = "CmdMgr";
-                    config.stackSize = 4096;
-                    config.priority = 2;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                        async_->sender = responsehandler;
+                        async_->errorFactory = errorReplyFactory;
+                    }
 
-                    eventTask_ = Core::OSAL::Factory::createTask(
-                        [this]()
-                        { this->eventLoop(); }, // Lambda que llama al bucle
-                        config);
+                    isRunning_ = true;
 
-                    if (eventTask_)
+                    if (executor_)
                     {
-                        isRunning_ = true;
-                        eventTask_->start();
-                        FP_LOG_I("CommandManager", "Tarea iniciada");
+                        if (!timers_)
+                            FP_LOG_W("CommandManager", "Executor sin TimerService: los timeouts solo se revisan al procesar comandos");
+                        // Lo que se encoló antes de arrancar
+                        for (auto &worker : workers_)
+                            schedule(*worker);
+                        FP_LOG_I("CommandManager", "%u shards sobre el executor", static_cast<unsigned>(workers_.size()));
+                        return;
                     }
+
+                    for (size_t i = 0; i < workers_.size(); ++i)
+                    {
+                        Worker *worker = workers_[i].get();
+
+                        Core::OSAL::TaskConfig taskConfig;
+                        taskConfig.name = "CmdMgr" + std::to_string(i);
+                        taskConfig.stackSize = config_.stackSize;
+                        taskConfig.priority = config_.priority;
+                        taskConfig.coreId = config_.coreId;
+
+                        worker->task = Core::OSAL::Factory::createTask(
+                            [this, worker]()
+                            { this->eventLoop(*worker); }, // Lambda que llama al bucle
+                            taskConfig);
+
+                        if (worker->task)
+                        {
+                            worker->task->start();
+                        }
+                    }
+                    FP_LOG_I("CommandManager", "Iniciados %u workers", static_cast<unsigned>(workers_.size()));
                 }
 
                 void stop()
                 {
-                    if (isRunning_ && eventTask_)
+                    if (!isRunning_)
+                        return;
+
+                    // Los workers revisan isRunning_ en cada timeout del timbre.
+                    isRunning_ = false;
+                    for (auto &worker : workers_)
                     {
-                        // Señalizamos que pare (necesitarías un mecanismo mejor para salir del bucle de la cola,
-                        // como enviar un paquete especial de "STOP" a la cola, o usar un timeout en receive).
-                        isRunning_ = false;
-                        // Por simplicidad aquí, forzamos stop si la implementación lo soporta
-                        eventTask_->stop();
+                        if (worker->task)
+                        {
+                            worker->task->stop();
+                        }
+                        // Con executor: esperamos al lote en marcha o encolado (sale al ver isRunning_)
+                        while (worker->signals.load() != 0)
+                        {
+                            Core::OSAL::Factory::sleep(1);
+                        }
                     }
                 }
 
+                // --- Estadísticas ---
+                size_t getInFlightCount()
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                    return async_->inFlight.size();
+                }
+                uint32_t getTimeoutCount() const { return async_->timeouts.load(); }
+                uint32_t getRejectedCount() const { return async_->rejected.load(); }
+                const OverloadStats &getOverloadStats() const { return stats_; }
+
             private:
-                std::unique_ptr<Core::OSAL::IQueue<Core::PacketEnvelope<PacketT>>> packetQueue_;
-                std::unique_ptr<Core::OSAL::ITask> eventTask_;
+                using CommandEntry = std::pair<int, std::shared_ptr<ICommand<PacketT>>>;
+
+                using EnvelopeQueue = Core::Utils::MpmcQueue<Core::PacketEnvelope<PacketT>>;
+
+                struct Worker
+                {
+                    explicit Worker(size_t depth) : probe("CommandManager.queue", depth) {}
+
+                    std::unique_ptr<EnvelopeQueue> queue;
+                    std::unique_ptr<EnvelopeQueue> priorityQueue; // Solo si hay comandos prioritarios
+                    std::unique_ptr<Core::OSAL::IEventFlags> doorbell;
+                    std::unique_ptr<Core::OSAL::ITask> task;
+                    std::atomic<uint32_t> signals{0}; // Con executor: avisos desde el último lote (0 = ninguno en marcha)
+                    Core::OSAL::QueueProbe probe; // Ocupación y descartes de los dos carriles
+                };
+
+                using Pending = Detail::PendingReply<PacketT>;
+
+                /**
+                 * @brief Estado de las peticiones en vuelo.
+                 * Va en un shared_ptr porque los tokens pueden sobrevivir al manager.
+                 */
+                struct AsyncState
+                {
+                    std::unique_ptr<Core::OSAL::IMutex> mutex = Core::OSAL::Factory::createMutex("CommandManager.async");
+                    std::vector<std::shared_ptr<Pending>> inFlight;
+                    SenderFunc sender;
+                    ErrorReplyFactory errorFactory;
+                    std::atomic<uint64_t> lastSweepMs{0};
+                    std::atomic<uint32_t> timeouts{0};
+                    std::atomic<uint32_t> rejected{0};
+                };
+
+                static constexpr Core::OSAL::IEventFlags::Bits kDoorbell = 1u << 0;
+
+                // Sobres por lote en el executor antes de ceder el hilo a otros trabajos
+                static constexpr size_t kExecutorBatch = 16;
+
+                CommandManagerConfig config_;
+                std::shared_ptr<AsyncState> async_;
+                OverloadStats stats_;
+                std::vector<std::unique_ptr<Worker>> workers_;
                 std::atomic<bool> isRunning_{false};
 
-                std::map<int, std::shared_ptr<ICommand<PacketT>>> commandMap_;
+                // Tabla plana ordenada por ID (búsqueda binaria, sin nodos en el heap)
+                std::vector<CommandEntry> commandTable_;
+                std::shared_ptr<ICommand<PacketT>> fallbackCommand_;
+                std::shared_ptr<Core::OSAL::TimerService> timers_;
+                std::shared_ptr<Core::OSAL::IExecutor> executor_;
+
+                ICommand<PacketT> *findCommand(int id) const
+                {
+                    auto it = std::lower_bound(commandTable_.begin(), commandTable_.end(), id,
+                                               [](const CommandEntry &entry, int key)
+                                               { return entry.first < key; });
+                    if (it != commandTable_.end() && it->first == id)
+                        return it->second.get();
+                    return fallbackCommand_.get();
+                }
+
+                // Devuelve el hueco de cuota que ocupaba un sobre normal al salir de la cola
+                void releaseQuota(const Core::PacketEnvelope<PacketT> &envelope)
+                {
+                    if (config_.overload.perClientQuota > 0 && envelope.client)
+                        envelope.client->queued.fetch_sub(1);
+                }
+
+                // Primero el carril prioritario, luego el normal
+                bool popNext(Worker &worker, Core::PacketEnvelope<PacketT> &envelope)
+                {
+                    if (worker.priorityQueue && worker.priorityQueue->tryPop(envelope))
+                    {
+                        worker.probe.received(1);
+                        return true;
+                    }
+                    if (worker.queue->tryPop(envelope))
+                    {
+                        worker.probe.received(1);
+                        releaseQuota(envelope);
+                        return true;
+                    }
+                    return false;
+                }
+
+                // fromNormalQueue: el sobre salió de la cola normal (la que lleva cuota)
+                void discard(Core::PacketEnvelope<PacketT> &envelope, bool fromNormalQueue)
+                {
+                    if (fromNormalQueue)
+                        releaseQuota(envelope);
+                    envelope.packet.reset();
+                }
 
-                static void eventTaskAdapter(void *arg)
+                void eventLoop(Worker &worker)
                 {
-                    static_cast<CommandManager *>(arg)->eventTask();
+                    // Como mucho cada sweepPeriodMs despertamos para revisar timeouts (sweepExpired) e isRunning_
+                    while (isRunning_)
+                    {
+                        if (worker.doorbell->waitAny(kDoorbell, config_.sweepPeriodMs))
+                        {
+                            // Vaciamos todo lo pendiente con un solo despertar
+                            drainQueues(worker, SIZE_MAX);
+                        }
+                        sweepExpired();
+                    }
+                    FP_LOG_I("CommandManager", "Worker finalizado");
                 }
 
-                void eventLoop()
+                // Procesa hasta maxItems sobres del worker; devuelve cuántos sacó
+                size_t drainQueues(Worker &worker, size_t maxItems)
                 {
                     Core::PacketEnvelope<PacketT> envelope;
-                    // Mientras deba correr, esperamos paquetes
-                    // Usamos un timeout razonable (ej. 1s) para poder comprobar isRunning_ periódicamente
+                    size_t done = 0;
+                    while (done < maxItems && popNext(worker, envelope))
+                    {
+                        ++done;
+                        std::unique_ptr<const PacketT> packet = std::move(envelope.packet);
+
+                        uint32_t maxAge = config_.overload.maxQueueAgeMs;
+                        if (maxAge > 0 && Core::OSAL::Factory::getSystemTimeMs() > envelope.enqueuedAtMs + maxAge)
+                        {
+                            stats_.expired++;
+                            sendError(envelope.channelId, packet->command);
+                            continue;
+                        }
+
+                        FP_LOG_D("CommandManager", "Procesando comando %d", packet->command);
+                        processContext(envelope.channelId, std::move(packet));
+                    }
+                    return done;
+                }
+
+                /**
+                 * @brief Pide un lote al executor para este worker.
+                 * Solo el aviso que pasa signals de 0 a 1 publica: así hay como mucho un
+                 * lote por worker en marcha y se conserva el orden de cada canal.
+                 */
+                void schedule(Worker &worker)
+                {
+                    if (worker.signals.fetch_add(1) != 0)
+                        return; // El lote en marcha verá este sobre
+                    if (!executor_->post([this, &worker]()
+                                         { this->runBatch(worker); }))
+                    {
+                        worker.signals.store(0); // Executor parado: los sobres esperan en la cola
+                    }
+                }
+
+                void runBatch(Worker &worker)
+                {
+                    uint32_t seen = worker.signals.load();
                     while (isRunning_)
                     {
-                        if (packetQueue_->receive(envelope, 1000))
+                        if (drainQueues(worker, kExecutorBatch) == kExecutorBatch)
                         {
-                            std::unique_ptr<const PacketT> packet(envelope.raw_packet_ptr);
-                            FP_LOG_I("CommandManager", "Procesando comando %d", packet->command);
-                            processContext(envelope.channelId, std::move(packet));
+                            // Puede quedar más: el lote sigue en otro trabajo para no acaparar el hilo
+                            if (executor_->post([this, &worker]()
+                                                { this->runBatch(worker); }))
+                                return;
+                            continue;
                         }
+                        sweepExpired();
+                        // Si llegaron avisos mientras vaciábamos, seen no coincide y damos otra vuelta
+                        if (worker.signals.compare_exchange_strong(seen, 0))
+                            return;
                     }
-                    FP_LOG_I("CommandManager", "Tarea finalizada");
+                    worker.signals.store(0);
                 }
 
                 void processContext(uint32_t channelId, std::unique_ptr<const PacketT> packet)
                 {
-                    auto it = commandMap_.find(packet->command);
+                    int commandId = packet->command;
+                    ICommand<PacketT> *command = findCommand(commandId);
+
+                    if (!command)
+                    {
+                        FP_LOG_D("CommandManager", "Comando no encontrado: %d (canal %u)", commandId, channelId);
+                        return;
+                    }
 
-                    if (it != commandMap_.end())
+                    uint32_t timeoutMs = command->getTimeoutMs();
+                    if (timeoutMs == 0)
+                        timeoutMs = config_.defaultTimeoutMs;
+
+                    auto pending = std::make_shared<Pending>();
+                    pending->channelId = channelId;
+                    pending->commandId = commandId;
+                    pending->deadlineMs = Core::OSAL::Factory::getSystemTimeMs() + timeoutMs;
+
+                    std::weak_ptr<AsyncState> weakState = async_;
+                    std::weak_ptr<Core::OSAL::TimerService> weakTimers = timers_;
+                    pending->deliver = [weakState](uint32_t replyChannel, std::unique_ptr<const PacketT> response)
                     {
-                        // creamos la lambda de respuesta "al vuelo"
-                        // Capturamos el 'sender_' y el 'channelId' específico de este paquete.
-                        ReplyFunc<PacketT> replyCallback = [this, channelId](std::unique_ptr<const PacketT> response)
+                        if (auto state = weakState.lock())
                         {
-                            if (this->responsehandler)
+                            SenderFunc sender;
                             {
-                                FP_LOG_W("skdhfj", "usando callbak de respuesta");
-                                this->responsehandler(channelId, std::move(response));
+                                std::lock_guard<Core::OSAL::IMutex> lock(*state->mutex);
+                                sender = state->sender;
                             }
-                        };
+                            if (sender)
+                                sender(replyChannel, std::move(response));
+                        }
+                    };
+                    pending->release = [weakState, weakTimers](Pending *done)
+                    {
+                        if (auto timers = weakTimers.lock())
+                            timers->cancel(done->timerId.load());
+                        if (auto state = weakState.lock())
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*state->mutex);
+                            auto &list = state->inFlight;
+                            list.erase(std::remove_if(list.begin(), list.end(),
+                                                      [done](const std::shared_ptr<Pending> &p)
+                                                      { return p.get() == done; }),
+                                       list.end());
+                        }
+                    };
 
-                        FP_LOG_W("skdhfj", "comando encontrado, ejecutamos comando");
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                        if (async_->inFlight.size() >= config_.maxInFlight)
+                        {
+                            async_->rejected++;
+                            pending.reset();
+                        }
+                        else
+                        {
+                            async_->inFlight.push_back(pending);
+                        }
+                    }
 
-                        // Ejecutamos el comando pasándole la forma fácil de responder
-                        it->second->execute(std::move(packet), replyCallback);
+                    if (!pending)
+                    {
+                        FP_LOG_W("CommandManager", "Límite de comandos en vuelo alcanzado, rechazado %d", commandId);
+                        sendError(channelId, commandId);
+                        return;
                     }
-                    else
+
+                    if (timers_)
+                    {
+                        std::weak_ptr<Pending> weakPending = pending;
+                        pending->timerId = timers_->scheduleOnce(uint64_t(timeoutMs) * 1000, [weakState, weakPending]()
+                                                                 {
+                            auto state = weakState.lock();
+                            auto p = weakPending.lock();
+                            if (state && p)
+                                expire(*state, *p); });
+                    }
+
+                    // El comando responde ahora (síncrono) o más tarde a través del token
+                    FP_PROFILE_SCOPE("Command.execute");
+                    command->executeAsync(std::move(packet), ReplyToken<PacketT>(pending));
+                }
+
+                void sendError(uint32_t channelId, int commandId)
+                {
+                    SenderFunc sender;
+                    ErrorReplyFactory factory;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                        sender = async_->sender;
+                        factory = async_->errorFactory;
+                    }
+                    if (sender && factory)
+                    {
+                        if (auto reply = factory(commandId))
+                            sender(channelId, std::move(reply));
+                    }
+                }
+
+                // Cierra una petición por timeout (con respuesta de error si hay factoría)
+                static bool expire(AsyncState &state, Pending &p)
+                {
+                    ErrorReplyFactory factory;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*state.mutex);
+                        factory = state.errorFactory;
+                    }
+                    std::unique_ptr<const PacketT> reply = factory ? factory(p.commandId) : nullptr;
+                    if (!p.finish(std::move(reply)))
+                        return false;
+
+                    state.timeouts++;
+                    FP_LOG_W("CommandManager", "Timeout del comando %d (canal %u)", p.commandId, p.channelId);
+                    return true;
+                }
+
+                // Expira las peticiones sin temporizador propio (no hay TimerService o no le
+                // quedaban huecos) cuyo deadline ha pasado. Como mucho una vez por periodo
+                // entre todos los workers.
+                void sweepExpired()
+                {
+                    uint64_t now = Core::OSAL::Factory::getSystemTimeMs();
+                    uint64_t last = async_->lastSweepMs.load();
+                    if (now < last + config_.sweepPeriodMs ||
+                        !async_->lastSweepMs.compare_exchange_strong(last, now))
+                        return;
+
+                    std::vector<std::shared_ptr<Pending>> expired;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*async_->mutex);
+                        for (const auto &p : async_->inFlight)
+                        {
+                            if (now >= p->deadlineMs && p->timerId.load() == Core::OSAL::TimerService::kInvalidTimer)
+                                expired.push_back(p);
+                        }
+                    }
+
+                    for (const auto &p : expired)
                     {
-                        FP_LOG_W("skdhfj", "comando no encontrado recivimos msg de %d", packet->command);
+                        expire(*async_, *p);
                     }
                 }
             };
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,376 @@
+#pragma once
+
+#include "FlightProxy/AppLogic/Command/ICommand.h"
+#include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace AppLogic
+    {
+        namespace Command
+        {
+            namespace Commands
+            {
+                struct MSP_PassthroughConfig
+                {
+                    bool defaultAllow = true;        // Comandos no listados: se reenvían o no
+                    size_t maxPendingPerCommand = 4; // Peticiones esperando respuesta por comando
+                    uint32_t timeoutMs = 500;        // Timeout de la respuesta de la FC
+                    // Una petición expirada sigue en la cola hasta este tiempo desde su envío
+                    // para absorber la respuesta tardía de la FC (0 = 4 * timeoutMs)
+                    uint32_t lateReplyMs = 0;
+                };
+
+                struct MSP_PassthroughStats
+                {
+                    std::atomic<uint32_t> forwarded{0}; // Peticiones enviadas a la FC
+                    std::atomic<uint32_t> replied{0};   // Respuestas entregadas al cliente
+                    std::atomic<uint32_t> denied{0};    // Bloqueadas por el filtro
+                    std::atomic<uint32_t> busy{0};      // Demasiadas pendientes para ese comando
+                    std::atomic<uint32_t> unmatched{0}; // Respuestas de la FC sin petición pendiente
+                    std::atomic<uint32_t> lateReplies{0}; // Respuestas a peticiones ya expiradas (descartadas)
+                    std::atomic<uint32_t> collapsed{0}; // Peticiones unidas a otra idéntica en vuelo
+
+                    // Latencia petición -> respuesta de la FC (por petición enviada, no por cliente)
+                    std::atomic<uint32_t> latencyCount{0};
+                    std::atomic<uint64_t> latencySumMs{0};
+                    std::atomic<uint32_t> latencyMaxMs{0};
+
+                    // Caché de lecturas: solo cuentan los comandos con TTL configurado
+                    std::atomic<uint32_t> cacheHits{0};
+                    std::atomic<uint32_t> cacheMisses{0};
+                    std::atomic<uint64_t> cacheAgeSumMs{0}; // Antigüedad de los datos servidos
+
+                    uint32_t latencyAvgMs() const
+                    {
+                        uint32_t count = latencyCount.load();
+                        return count ? static_cast<uint32_t>(latencySumMs.load() / count) : 0;
+                    }
+
+                    uint32_t cacheAgeAvgMs() const
+                    {
+                        uint32_t hits = cacheHits.load();
+                        return hits ? static_cast<uint32_t>(cacheAgeSumMs.load() / hits) : 0;
+                    }
+                };
+
+                /**
+                 * @brief Reenvía a la FC los comandos MSP que no atiende ningún comando local
+                 * y devuelve la respuesta al cliente que la pidió.
+                 *
+                 * Se registra como comando por defecto del CommandManager. MSP no lleva número
+                 * de secuencia, así que las respuestas se emparejan por comando en orden FIFO
+                 * (la FC responde en el orden en que recibe). Una petición cuyo cliente ya
+                 * expiró se queda en la cola como "lápida" para absorber su respuesta
+                 * tardía: así esa respuesta no le llega a la siguiente petición del mismo
+                 * comando (quizá de otro cliente). Si los paquetes conservan su trama
+                 * original (MspDecoder con keepRawFrame) se reenvían sin recodificar.
+                 *
+                 * Colapso de lecturas: en los comandos marcados con setCollapsible(), una
+                 * petición idéntica (mismo comando y payload) a otra que ya está en vuelo no
+                 * se envía; se une a ella y todos reciben la misma respuesta.
+                 *
+                 * Caché de lectura: en los comandos con TTL (setCacheTtl) se guarda la última
+                 * respuesta de la FC, venga de quien venga la petición (también los DataNodes).
+                 * Una lectura sin payload dentro del TTL se responde desde el proxy.
+                 */
+                template <typename PacketT>
+                class MSP_Passthrough : public IAsyncCommand<PacketT>,
+                                        public std::enable_shared_from_this<MSP_Passthrough<PacketT>>
+                {
+                public:
+                    // fcChannel debe recibir todas las respuestas de la FC
+                    // (p. ej. ChannelDisgregatorT::createCatchAllChannel())
+                    MSP_Passthrough(std::shared_ptr<Core::Channel::IChannelT<PacketT>> fcChannel,
+                                    const MSP_PassthroughConfig &config = MSP_PassthroughConfig())
+                        : fcChannel_(std::move(fcChannel)),
+                          config_(config),
+                          m_mutex(Core::OSAL::Factory::createMutex("MSP_Passthrough"))
+                    {
+                        if (config_.lateReplyMs == 0)
+                            config_.lateReplyMs = 4 * config_.timeoutMs;
+
+                        fcChannel_->onPacket = [this](std::unique_ptr<const PacketT> packet)
+                        {
+                            this->onFcPacket(std::move(packet));
+                        };
+                    }
+
+                    ~MSP_Passthrough() override
+                    {
+                        fcChannel_->onPacket = nullptr;
+                    }
+
+                    // El filtro se configura antes de arrancar el CommandManager. Solo se
+                    // guardan las excepciones a defaultAllow (lista ordenada, búsqueda binaria).
+                    void allow(uint16_t command) { setMember(filterExceptions_, command, !config_.defaultAllow); }
+                    void deny(uint16_t command) { setMember(filterExceptions_, command, config_.defaultAllow); }
+                    bool isAllowed(uint16_t command) const { return config_.defaultAllow != isMember(filterExceptions_, command); }
+
+                    // Solo para lecturas sin efectos: varias peticiones iguales comparten respuesta
+                    void setCollapsible(uint16_t command, bool enabled = true) { setMember(collapsible_, command, enabled); }
+                    bool isCollapsible(uint16_t command) const { return isMember(collapsible_, command); }
+
+                    // TTL de la caché para un comando (0 = sin caché). Configurar antes de arrancar.
+                    void setCacheTtl(uint16_t command, uint32_t ttlMs)
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        if (ttlMs == 0)
+                            cache_.erase(command);
+                        else
+                            cache_[command].ttlMs = ttlMs;
+                    }
+
+                    int getID() override { return -1; } // No tiene ID propio: es el comando por defecto
+                    uint32_t getTimeoutMs() override { return config_.timeoutMs; }
+
+                    void executeAsync(std::unique_ptr<const PacketT> packet, ReplyToken<PacketT> token) override
+                    {
+                        uint16_t command = packet->command;
+
+                        if (!isAllowed(command))
+                        {
+                            stats_.denied++;
+                            FP_LOG_D("Passthrough", "Comando %u bloqueado por el filtro", command);
+                            token.complete(makeError(command));
+                            return;
+                        }
+
+                        std::unique_ptr<const PacketT> cached;
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                            cached = lookupCache(*packet);
+                        }
+                        if (cached)
+                        {
+                            // Respondemos sin tocar la FC
+                            token.complete(std::move(cached));
+                            return;
+                        }
+
+                        bool queued = false;
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                            auto &fifo = pending_[command];
+                            dropLost(fifo);
+
+                            if (isCollapsible(command))
+                            {
+                                for (auto &request : fifo)
+                                {
+                                    // A una lápida no: su respuesta se va a descartar
+                                    if (!request->finished() && request->payload == packet->payload)
+                                    {
+                                        request->waiters.push_back(token);
+                                        stats_.collapsed++;
+                                        return; // Ya hay una igual en camino
+                                    }
+                                }
+                            }
+
+                            if (fifo.size() < config_.maxPendingPerCommand)
+                            {
+                                auto request = std::make_shared<Request>();
+                                request->sentAtMs = Core::OSAL::Factory::getSystemTimeMs();
+                                if (isCollapsible(command))
+                                    request->payload = packet->payload.toVector();
+                                request->waiters.push_back(token);
+                                fifo.push_back(std::move(request));
+                                queued = true;
+                            }
+                        }
+
+                        if (!queued)
+                        {
+                            stats_.busy++;
+                            FP_LOG_D("Passthrough", "Demasiadas peticiones pendientes del comando %u", command);
+                            token.complete(makeError(command));
+                            return;
+                        }
+
+                        stats_.forwarded++;
+                        fcChannel_->sendPacket(std::move(packet));
+                    }
+
+                    const MSP_PassthroughStats &getStats() const { return stats_; }
+
+                private:
+                    void onFcPacket(std::unique_ptr<const PacketT> packet)
+                    {
+                        // Solo nos interesan respuestas ('>' o error '!')
+                        if (packet->direction == '<')
+                            return;
+
+                        std::shared_ptr<Request> request;
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                            storeCache(*packet);
+
+                            auto it = pending_.find(packet->command);
+                            if (it != pending_.end())
+                            {
+                                dropLost(it->second);
+                                if (!it->second.empty())
+                                {
+                                    request = std::move(it->second.front());
+                                    it->second.pop_front();
+                                }
+                            }
+                        }
+
+                        if (!request)
+                        {
+                            // Respuesta a una petición propia del proxy (DataNodes) o ya expirada
+                            stats_.unmatched++;
+                            return;
+                        }
+
+                        recordLatency(Core::OSAL::Factory::getSystemTimeMs() - request->sentAtMs);
+
+                        if (request->finished())
+                        {
+                            // Lápida: sus clientes ya recibieron el timeout
+                            stats_.lateReplies++;
+                            return;
+                        }
+
+                        // Copias para los que se unieron; el original para el último
+                        auto &waiters = request->waiters;
+                        for (size_t i = 0; i < waiters.size(); ++i)
+                        {
+                            bool last = (i + 1 == waiters.size());
+                            std::unique_ptr<const PacketT> reply = last ? std::move(packet)
+                                                                        : std::make_unique<const PacketT>(*packet);
+                            if (waiters[i].complete(std::move(reply)))
+                                stats_.replied++;
+                        }
+                    }
+
+                    struct CacheEntry
+                    {
+                        uint32_t ttlMs = 0;
+                        std::shared_ptr<const PacketT> reply; // Con su trama original si se conservó (copia propia)
+                        uint64_t storedAtMs = 0;
+                    };
+
+                    // Con m_mutex tomado. Devuelve una copia de la respuesta si está fresca.
+                    std::unique_ptr<const PacketT> lookupCache(const PacketT &request)
+                    {
+                        auto it = cache_.find(request.command);
+                        if (it == cache_.end() || !request.payload.empty())
+                            return nullptr; // Sin caché, o lectura con parámetros
+
+                        const CacheEntry &entry = it->second;
+                        uint64_t now = Core::OSAL::Factory::getSystemTimeMs();
+                        if (!entry.reply || now - entry.storedAtMs > entry.ttlMs)
+                        {
+                            stats_.cacheMisses++;
+                            return nullptr;
+                        }
+
+                        stats_.cacheHits++;
+                        stats_.cacheAgeSumMs += now - entry.storedAtMs;
+                        return std::make_unique<const PacketT>(*entry.reply);
+                    }
+
+                    // Con m_mutex tomado
+                    void storeCache(const PacketT &reply)
+                    {
+                        if (reply.direction != '>')
+                            return; // Los errores no se cachean
+
+                        auto it = cache_.find(reply.command);
+                        if (it == cache_.end())
+                            return;
+
+                        // Copia propia: la caché no debe retener bloques de recepción durante el TTL
+                        it->second.reply = std::make_shared<const PacketT>(Core::detachedCopy(reply));
+                        it->second.storedAtMs = Core::OSAL::Factory::getSystemTimeMs();
+                    }
+
+                    // Petición enviada a la FC y los clientes que esperan su respuesta
+                    struct Request
+                    {
+                        std::vector<uint8_t> payload; // Solo se guarda si el comando es colapsable
+                        std::vector<ReplyToken<PacketT>> waiters;
+                        uint64_t sentAtMs = 0;
+
+                        bool finished() const
+                        {
+                            for (const auto &waiter : waiters)
+                            {
+                                if (!waiter.isDone())
+                                    return false;
+                            }
+                            return true;
+                        }
+                    };
+
+                    /**
+                     * @brief Quita del frente las lápidas que ya no esperan respuesta
+                     * (lateReplyMs desde el envío): la FC perdió la petición.
+                     */
+                    void dropLost(std::deque<std::shared_ptr<Request>> &fifo)
+                    {
+                        uint64_t now = Core::OSAL::Factory::getSystemTimeMs();
+                        while (!fifo.empty() && fifo.front()->finished() &&
+                               now - fifo.front()->sentAtMs > config_.lateReplyMs)
+                        {
+                            fifo.pop_front();
+                        }
+                    }
+
+                    static bool isMember(const std::vector<uint16_t> &set, uint16_t command)
+                    {
+                        return std::binary_search(set.begin(), set.end(), command);
+                    }
+
+                    static void setMember(std::vector<uint16_t> &set, uint16_t command, bool member)
+                    {
+                        auto it = std::lower_bound(set.begin(), set.end(), command);
+                        bool present = (it != set.end() && *it == command);
+                        if (member && !present)
+                            set.insert(it, command);
+                        else if (!member && present)
+                            set.erase(it);
+                    }
+
+                    void recordLatency(uint64_t elapsedMs)
+                    {
+                        uint32_t ms = static_cast<uint32_t>(elapsedMs);
+                        stats_.latencyCount++;
+                        stats_.latencySumMs += ms;
+                        uint32_t prev = stats_.latencyMaxMs.load();
+                        while (ms > prev && !stats_.latencyMaxMs.compare_exchange_weak(prev, ms))
+                        {
+                        }
+                    }
+
+                    static std::unique_ptr<const PacketT> makeError(uint16_t command)
+                    {
+                        return std::make_unique<const PacketT>('!', command, std::vector<uint8_t>{});
+                    }
+
+                    std::shared_ptr<Core::Channel::IChannelT<PacketT>> fcChannel_;
+                    MSP_PassthroughConfig config_;
+                    std::unique_ptr<Core::OSAL::IMutex> m_mutex;
+                    std::map<uint16_t, std::deque<std::shared_ptr<Request>>> pending_;
+                    std::vector<uint16_t> filterExceptions_; // Comandos que no siguen defaultAllow (ordenados)
+                    std::vector<uint16_t> collapsible_;      // Comandos cuyas lecturas iguales se unen (ordenados)
+                    std::map<uint16_t, CacheEntry> cache_;
+                    MSP_PassthroughStats stats_;
+                };
+            }
+        }
+    }
+}
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "FlightProxy/AppLogic/Command/ReplyToken.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
 namespace FlightProxy
 {
     namespace AppLogic
@@ -14,9 +20,56 @@ namespace FlightProxy
             {
             public:
                 virtual ~ICommand() = default;
+
+                /**
+                 * @brief Ejecución síncrona: se responde antes de volver.
+                 * Los comandos sencillos solo implementan este método; los asíncronos
+                 * derivan de IAsyncCommand.
+                 */
                 virtual void execute(std::unique_ptr<const PacketT> packet, ReplyFunc<PacketT> reply) = 0;
+
+                /**
+                 * @brief Ejecución asíncrona: el comando guarda el token y lo completa
+                 * cuando tenga la respuesta (p. ej. desde la tarea del canal de la FC),
+                 * sin bloquear al worker del CommandManager.
+                 * Por defecto delega en execute().
+                 */
+                virtual void executeAsync(std::unique_ptr<const PacketT> packet, ReplyToken<PacketT> token)
+                {
+                    execute(std::move(packet), [token](std::unique_ptr<const PacketT> response) mutable
+                            { token.complete(std::move(response)); });
+                }
+
+                /**
+                 * @brief Timeout de la respuesta en ms (0 = el por defecto del CommandManager).
+                 */
+                virtual uint32_t getTimeoutMs() { return 0; }
+
                 virtual int getID() = 0;
             };
+
+            /**
+             * @brief Base de los comandos que solo responden de forma asíncrona.
+             * executeAsync() es obligatorio; execute() lo adapta a un ReplyFunc para
+             * quien llame sin CommandManager (la respuesta puede llegar más tarde).
+             */
+            template <typename PacketT>
+            class IAsyncCommand : public ICommand<PacketT>
+            {
+            public:
+                void executeAsync(std::unique_ptr<const PacketT> packet, ReplyToken<PacketT> token) override = 0;
+
+                void execute(std::unique_ptr<const PacketT> packet, ReplyFunc<PacketT> reply) final
+                {
+                    auto state = std::make_shared<Detail::PendingReply<PacketT>>();
+                    state->deliver = [reply](uint32_t, std::unique_ptr<const PacketT> response)
+                    {
+                        if (reply)
+                            reply(std::move(response));
+                    };
+                    executeAsync(std::move(packet), ReplyToken<PacketT>(std::move(state)));
+                }
+            };
         }
     }
-}
\ No newline at end of file
+}
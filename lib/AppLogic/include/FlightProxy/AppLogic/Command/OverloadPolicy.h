@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace AppLogic
+    {
+        namespace Command
+        {
+            /**
+             * @brief Políticas de descarte de la entrada de comandos cuando se satura.
+             * Por defecto se comporta como antes: si la cola está llena se pierde el nuevo.
+             */
+            struct OverloadPolicy
+            {
+                // Con la cola llena descarta el comando más antiguo en lugar del recién llegado
+                bool dropOldest = false;
+
+                // Comandos críticos: van por un carril propio que se atiende primero
+                // y no cuentan para la cuota del cliente
+                std::vector<int> priorityCommands;
+
+                // Máximo de comandos encolados por cliente (0 = sin límite). El contador
+                // viaja en el sobre (PacketEnvelope::client); sin él no hay cuota
+                uint32_t perClientQuota = 0;
+
+                // Un comando que espera en cola más de esto se descarta (0 = sin límite)
+                uint32_t maxQueueAgeMs = 0;
+
+                bool isPriority(int commandId) const
+                {
+                    return std::binary_search(priorityCommands.begin(), priorityCommands.end(), commandId);
+                }
+
+                // Deja la lista de prioridades ordenada para isPriority()
+                void normalize()
+                {
+                    std::sort(priorityCommands.begin(), priorityCommands.end());
+                    priorityCommands.erase(std::unique(priorityCommands.begin(), priorityCommands.end()),
+                                           priorityCommands.end());
+                }
+            };
+
+            /**
+             * @brief Contadores de cada política (solo se incrementan).
+             */
+            struct OverloadStats
+            {
+                std::atomic<uint32_t> accepted{0};
+                std::atomic<uint32_t> acceptedPriority{0};
+                std::atomic<uint32_t> droppedNewest{0}; // Cola llena, se pierde el que llega
+                std::atomic<uint32_t> droppedOldest{0}; // Cola llena, se expulsa el más antiguo
+                std::atomic<uint32_t> quotaRejected{0}; // Cliente por encima de su cuota
+                std::atomic<uint32_t> expired{0};       // Demasiado tiempo en cola
+            };
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace FlightProxy
+{
+    namespace AppLogic
+    {
+        namespace Command
+        {
+            namespace Detail
+            {
+                /**
+                 * @brief Estado compartido de una respuesta pendiente.
+                 * Lo crea el CommandManager y lo comparten el token (handler) y la
+                 * lista de peticiones en vuelo (timeouts). Solo la primera llamada a
+                 * finish() tiene efecto.
+                 */
+                template <typename PacketT>
+                struct PendingReply
+                {
+                    uint32_t channelId = 0;
+                    int commandId = 0;
+                    uint64_t deadlineMs = 0;
+                    std::atomic<bool> done{false};
+                    std::atomic<uint32_t> timerId{0}; // Temporizador del timeout (si hay TimerService)
+
+                    // Los rellena el CommandManager
+                    std::function<void(uint32_t, std::unique_ptr<const PacketT>)> deliver;
+                    std::function<void(PendingReply<PacketT> *)> release;
+
+                    bool finish(std::unique_ptr<const PacketT> reply)
+                    {
+                        bool expected = false;
+                        if (!done.compare_exchange_strong(expected, true))
+                            return false; // Ya respondida o expirada
+
+                        if (reply && deliver)
+                            deliver(channelId, std::move(reply));
+                        if (release)
+                            release(this);
+                        return true;
+                    }
+                };
+            }
+
+            /**
+             * @brief Token para responder a un comando más tarde, desde cualquier tarea.
+             * Es copiable; la respuesta solo se entrega una vez. Si el token se completa
+             * después del timeout, complete() devuelve false y la respuesta se descarta.
+             */
+            template <typename PacketT>
+            class ReplyToken
+            {
+            public:
+                ReplyToken() = default;
+                explicit ReplyToken(std::shared_ptr<Detail::PendingReply<PacketT>> state) : state_(std::move(state)) {}
+
+                bool complete(std::unique_ptr<const PacketT> reply)
+                {
+                    return state_ && state_->finish(std::move(reply));
+                }
+
+                // Termina la petición sin enviar respuesta (libera el hueco de concurrencia)
+                void cancel()
+                {
+                    if (state_)
+                        state_->finish(nullptr);
+                }
+
+                bool valid() const { return static_cast<bool>(state_); }
+                bool isDone() const { return !state_ || state_->done.load(); }
+
+                uint32_t channelId() const { return state_ ? state_->channelId : 0; }
+                int commandId() const { return state_ ? state_->commandId : 0; }
+                uint64_t deadlineMs() const { return state_ ? state_->deadlineMs : 0; }
+
+            private:
+                std::shared_ptr<Detail::PendingReply<PacketT>> state_;
+            };
+        }
+    }
+}
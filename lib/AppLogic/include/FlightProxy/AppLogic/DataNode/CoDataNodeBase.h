@@ -0,0 +1,53 @@
+#pragma once
+
+#include "FlightProxy/Core/Coro/CoTask.h"
+
+#if FP_HAS_COROUTINES
+
+#include "FlightProxy/AppLogic/DataNode/IDataNodeBase.h"
+
+#include <atomic>
+#include <memory>
+
+namespace FlightProxy
+{
+    namespace AppLogic
+    {
+        namespace DataNode
+        {
+            /**
+             * @brief DataNode escrito como corrutina: cada transact() arranca un
+             * ciclo() si el anterior ya terminó. El ciclo puede encadenar varias
+             * peticiones al FC (co_await) sin bloquear la tarea del DataNodesManager.
+             *
+             * Mientras un ciclo está en marcha se queda con una referencia al nodo,
+             * así que hay que crearlo con std::make_shared.
+             */
+            class CoDataNodeBase : public IDataNodeBase, public std::enable_shared_from_this<CoDataNodeBase>
+            {
+            public:
+                void transact() override
+                {
+                    // Si el FC tarda más que el periodo, se salta este turno
+                    if (m_enCurso.exchange(true))
+                        return;
+                    ejecutar(shared_from_this()).detach();
+                }
+
+            protected:
+                virtual Core::Coro::CoTask<void> ciclo() = 0;
+
+            private:
+                static Core::Coro::CoTask<void> ejecutar(std::shared_ptr<CoDataNodeBase> self)
+                {
+                    co_await self->ciclo();
+                    self->m_enCurso.store(false);
+                }
+
+                std::atomic<bool> m_enCurso{false};
+            };
+        } // namespace DataNode
+    } // namespace AppLogic
+} // namespace FlightProxy
+
+#endif
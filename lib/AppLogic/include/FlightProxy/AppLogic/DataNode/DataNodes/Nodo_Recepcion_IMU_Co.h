@@ -0,0 +1,88 @@
+#pragma once
+
+#include "FlightProxy/AppLogic/DataNode/CoDataNodeBase.h"
+
+#if FP_HAS_COROUTINES
+
+#include "FlightProxy/Channel/RequesterT.h"
+#include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/FlightProxyTypes.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+#include "FlightProxy/Core/Protocol/MspProtocol.h"
+
+#include <functional>
+#include <memory>
+
+namespace FlightProxy
+{
+    namespace AppLogic
+    {
+        namespace DataNode
+        {
+            namespace DataNodes
+            {
+                /**
+                 * @brief Igual que Nodo_Recepcion_IMU pero con co_await: la petición
+                 * y su respuesta van seguidas en ciclo(), con timeout en lugar del
+                 * flag m_esperandoRespuesta.
+                 */
+                class Nodo_Recepcion_IMU_Co : public CoDataNodeBase
+                {
+                private:
+                    Channel::RequesterT<Core::MspPacket> m_fc;
+                    std::function<void(Core::IMUData)> m_productor;
+                    uint32_t m_timeoutMs;
+
+                protected:
+                    Core::Coro::CoTask<void> ciclo() override
+                    {
+                        auto reply = co_await m_fc.request(Core::Protocol::MSP_IMU_DATA, m_timeoutMs);
+                        if (!reply)
+                            co_return; // Timeout o canal cerrado: se reintenta en el siguiente periodo
+
+                        // 18 bytes: 9 valores de 2 bytes (los 3 últimos no los usamos)
+                        const auto &payload = reply->payload;
+                        if (payload.size() < 18)
+                            co_return;
+
+                        Core::IMUData datos_imu;
+                        datos_imu.accel_x = static_cast<int16_t>(payload[0] | (payload[1] << 8));
+                        datos_imu.accel_y = static_cast<int16_t>(payload[2] | (payload[3] << 8));
+                        datos_imu.accel_z = static_cast<int16_t>(payload[4] | (payload[5] << 8));
+
+                        datos_imu.gyro_x = static_cast<int16_t>(payload[6] | (payload[7] << 8));
+                        datos_imu.gyro_y = static_cast<int16_t>(payload[8] | (payload[9] << 8));
+                        datos_imu.gyro_z = static_cast<int16_t>(payload[10] | (payload[11] << 8));
+
+                        m_productor(datos_imu);
+                    }
+
+                public:
+                    Nodo_Recepcion_IMU_Co(std::shared_ptr<Core::Channel::IChannelT<Core::MspPacket>> virtualChannelIMUData,
+                                          std::function<void(Core::IMUData)> productorIMUData,
+                                          std::shared_ptr<Core::OSAL::TimerService> timers,
+                                          uint32_t timeoutMs = 200)
+                        : m_fc(virtualChannelIMUData,
+                               [](const Core::MspPacket &pkt)
+                               { return pkt.command; },
+                               timers, 1),
+                          m_productor(productorIMUData), m_timeoutMs(timeoutMs)
+                    {
+                        m_fc.requestFactory = [](Channel::CommandId command)
+                        {
+                            return std::make_unique<const Core::MspPacket>('<', command, Core::Utils::PayloadBytes{});
+                        };
+                    }
+
+                    // Antes del primer transact()
+                    void setExecutor(std::shared_ptr<Core::OSAL::IExecutor> executor)
+                    {
+                        m_fc.setExecutor(std::move(executor));
+                    }
+                };
+            } // namespace DataNodes
+        } // namespace DataNode
+    } // namespace AppLogic
+} // namespace FlightProxy
+
+#endif
@@ -2,7 +2,10 @@
 
 #include "FlightProxy/Core/Utils/Logger.h"
 #include "FlightProxy/AppLogic/DataNode/IDataNodeBase.h"
+#include "FlightProxy/Core/OSAL/IExecutor.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+#include "FlightProxy/Core/Utils/Profiler.h"
 
 #include <vector>
 #include <memory>
@@ -14,6 +17,14 @@ namespace FlightProxy
     {
         namespace DataNode
         {
+            /**
+             * @brief Ejecuta el transact() de cada DataNode con su periodo.
+             *
+             * Cada nodo es un temporizador periódico del TimerService (propio o
+             * compartido con otros componentes): no hay tarea haciendo polling.
+             * Con un executor el temporizador solo publica el transact(), que corre en
+             * un worker; si el anterior de ese nodo aún no terminó, se salta el periodo.
+             */
             class DataNodesManager : public std::enable_shared_from_this<DataNodesManager>
             {
             private:
@@ -21,82 +32,117 @@ namespace FlightProxy
                 {
                     std::shared_ptr<IDataNodeBase> task;
                     uint64_t period_ms;
-                    uint64_t next_run;
+                    Core::OSAL::TimerService::TimerId timer = Core::OSAL::TimerService::kInvalidTimer;
+                    std::shared_ptr<std::atomic<bool>> busy = std::make_shared<std::atomic<bool>>(false);
                 };
                 std::vector<Job> m_Jobs;
 
                 std::atomic<bool> isRunning_{false};
 
-                std::unique_ptr<Core::OSAL::ITask> eventTask_;
+                std::shared_ptr<Core::OSAL::TimerService> timers_;
+                bool ownsTimers_;
+                std::shared_ptr<Core::OSAL::IExecutor> executor_;
 
             public:
-                DataNodesManager()
+                // Sin servicio de temporizadores se crea uno propio
+                explicit DataNodesManager(std::shared_ptr<Core::OSAL::TimerService> timers = nullptr)
+                    : timers_(std::move(timers)), ownsTimers_(!timers_)
                 {
+                    if (ownsTimers_)
+                    {
+                        Core::OSAL::TimerServiceConfig config;
+                        config.task.name = "DataNodes";
+                        config.task.stackSize = 4096;
+                        config.task.priority = 2;
+                        timers_ = std::make_shared<Core::OSAL::TimerService>(config);
+                    }
+                }
+
+                ~DataNodesManager()
+                {
+                    stop();
                 }
 
                 void addDataNode(std::shared_ptr<IDataNodeBase> dataNode, uint64_t samplingPeriodMs)
                 {
-                    // m_dataNodes.push_back(dataNode);
                     Job newJob;
                     newJob.task = dataNode;
                     newJob.period_ms = samplingPeriodMs;
-                    newJob.next_run = Core::OSAL::Factory::getSystemTimeMs() + samplingPeriodMs;
                     m_Jobs.push_back(newJob);
+
+                    if (isRunning_)
+                        arm(m_Jobs.back());
                 }
 
-                void start()
+                // Los transact() se ejecutan en el executor y no en la tarea de los
+                // temporizadores. Asignar antes de start().
+                void setExecutor(std::shared_ptr<Core::OSAL::IExecutor> executor)
                 {
                     if (isRunning_)
+                    {
+                        FP_LOG_W("DataNodesManager", "setExecutor ignorado: el manager ya está en marcha");
                         return;
+                    }
+                    executor_ = std::move(executor);
+                }
 
-                    // 2. Configurar y crear la tarea
-                    Core::OSAL::TaskConfig config;
-                    config.name = "CmdMgr";
-                    config.stackSize = 4096;
-                    config.priority = 2;
-
-                    eventTask_ = Core::OSAL::Factory::createTask(
-                        [this]()
-                        { this->eventLoop(); }, // Lambda que llama al bucle
-                        config);
+                void start()
+                {
+                    if (isRunning_)
+                        return;
 
-                    if (eventTask_)
+                    isRunning_ = true;
+                    for (auto &job : m_Jobs)
                     {
-                        isRunning_ = true;
-                        eventTask_->start();
-                        FP_LOG_I("CommandManager", "Tarea iniciada");
+                        arm(job);
                     }
+                    if (ownsTimers_)
+                        timers_->start();
+                    FP_LOG_I("DataNodesManager", "Iniciados %u nodos", static_cast<unsigned>(m_Jobs.size()));
                 }
 
                 void stop()
                 {
-                    if (isRunning_ && eventTask_)
+                    if (!isRunning_)
+                        return;
+
+                    isRunning_ = false;
+                    for (auto &job : m_Jobs)
                     {
-                        // Señalizamos que pare (necesitarías un mecanismo mejor para salir del bucle de la cola,
-                        // como enviar un paquete especial de "STOP" a la cola, o usar un timeout en receive).
-                        isRunning_ = false;
-                        // Por simplicidad aquí, forzamos stop si la implementación lo soporta
-                        eventTask_->stop();
+                        timers_->cancel(job.timer);
+                        job.timer = Core::OSAL::TimerService::kInvalidTimer;
                     }
+                    if (ownsTimers_)
+                        timers_->stop();
+                    FP_LOG_I("DataNodesManager", "Nodos parados");
                 }
 
             private:
-                void eventLoop()
+                void arm(Job &job)
                 {
-                    while (isRunning_)
+                    std::shared_ptr<IDataNodeBase> node = job.task;
+                    if (!executor_)
                     {
-                        uint64_t now = Core::OSAL::Factory::getSystemTimeMs();
-                        for (auto &job : m_Jobs)
-                        {
-                            if (now >= job.next_run)
-                            {
-                                job.task->transact();
-                                job.next_run = (job.next_run + job.period_ms <= now) ? now : (job.next_run + job.period_ms);
-                            }
-                        }
-                        // Core::OSAL::Factory::sleep(1); // Evitar busy-waiting
+                        job.timer = timers_->schedulePeriodic(job.period_ms * 1000, [node]()
+                                                              {
+                                                                  FP_PROFILE_SCOPE("DataNode.transact");
+                                                                  node->transact(); });
+                        return;
                     }
-                    FP_LOG_I("DataNodesManager", "Tarea finalizada");
+
+                    std::shared_ptr<Core::OSAL::IExecutor> executor = executor_;
+                    std::shared_ptr<std::atomic<bool>> busy = job.busy;
+                    job.timer = timers_->schedulePeriodic(job.period_ms * 1000, [node, executor, busy]()
+                                                          {
+                                                              if (busy->exchange(true))
+                                                                  return; // El anterior sigue en marcha
+                                                              bool posted = executor->post([node, busy]()
+                                                                                           {
+                                                                                               FP_PROFILE_SCOPE("DataNode.transact");
+                                                                                               node->transact();
+                                                                                               busy->store(false); });
+                                                              if (!posted)
+                                                                  busy->store(false); });
                 }
             };
         } // namespace DataNode
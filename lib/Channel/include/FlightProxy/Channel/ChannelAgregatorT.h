@@ -2,9 +2,11 @@
 
 #include "FlightProxy/Core/FlightProxyTypes.h"
 #include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/Protocol/IEncoderT.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
-#include <mutex>
-#include <map>
+#include "FlightProxy/Core/Utils/SlotMap.h"
+#include "FlightProxy/Core/Utils/SpscRing.h"
+#include <vector>
 #include <atomic>
 #include <memory>
 #include <functional>
@@ -13,66 +15,370 @@ namespace FlightProxy
 {
     namespace Channel
     {
+        struct ChannelAgregatorConfig
+        {
+            size_t maxClients = 16;     // Huecos del registro de canales
+            size_t ingressDepth = 8;    // Paquetes en espera por cliente (se redondea a potencia de 2)
+            uint32_t defaultWeight = 1; // Paquetes por ronda DRR para un cliente nuevo
+            uint32_t retryMs = 10;      // Espera antes de reintentar si el destino está lleno
+            uint32_t stackSize = 4096;
+            int priority = 3;
+        };
 
+        /**
+         * @brief Agrega varios canales (clientes GCS) en un único flujo de paquetes.
+         *
+         * Cada cliente tiene su pequeña cola de entrada y una tarea de bombeo reparte
+         * el acceso a onPacketFromAnyChannel con Deficit Round Robin: en cada ronda un
+         * cliente puede entregar hasta 'weight' paquetes. Un cliente que inunda solo
+         * llena (y pierde) su propia cola, sin retrasar a los demás.
+         *
+         * Los canales viven en un SlotMap: el id de canal es índice + generación, así
+         * que response() es O(1), no bloquea y descarta respuestas a clientes ya cerrados.
+         *
+         * broadcast() codifica el paquete una sola vez y entrega la misma trama a todos
+         * los clientes (o a los que pasen el filtro).
+         */
         template <typename PacketT>
         class ChannelAgregatorT : public std::enable_shared_from_this<ChannelAgregatorT<PacketT>>
         {
         public:
-            ChannelAgregatorT() : m_mutex(Core::OSAL::Factory::createMutex()) {}
-            ~ChannelAgregatorT() {}
+            ChannelAgregatorT(const ChannelAgregatorConfig &config = ChannelAgregatorConfig())
+                : config_(config),
+                  clients_(config.maxClients),
+                  doorbell_(Core::OSAL::Factory::createEventFlags())
+            {
+            }
 
-            void addChannel(std::shared_ptr<FlightProxy::Core::Channel::IChannelT<PacketT>> channel)
+            ~ChannelAgregatorT()
             {
-                std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                stop();
+            }
 
-                // Id unico para cada canal nuevo
-                uint32_t myId = nextChannelId_++;
+            /**
+             * @brief Registra un canal y devuelve su id (kInvalidChannelId si el registro está lleno).
+             */
+            uint32_t addChannel(std::shared_ptr<FlightProxy::Core::Channel::IChannelT<PacketT>> channel)
+            {
+                auto client = std::make_shared<ClientState>(channel, config_.ingressDepth, config_.defaultWeight);
+                std::weak_ptr<ClientState> weakClient = client;
 
-                // Metemos en el map con el id
-                channelsById_[myId] = channel;
+                // El id lo da el hueco del registro (índice + generación)
+                uint32_t myId = clients_.insert(client);
+                if (myId == kInvalidChannelId)
+                {
+                    FP_LOG_W("AGREG", "Registro de canales lleno (%u), canal rechazado", (unsigned)config_.maxClients);
+                    return kInvalidChannelId;
+                }
+                client->id = myId;
 
-                channel->onClose = [this, myId, channel]()
+                channel->onClose = [this, myId]()
                 {
-                    FP_LOG_I("MAIN", "Canal cerrado. Borrándolo de la lista.");
-                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
-                    channelsById_.erase(myId);
+                    FP_LOG_I("AGREG", "Canal cerrado. Borrándolo de la lista.");
+                    clients_.erase(myId);
                 };
 
-                channel->onPacket = [this, myId](std::unique_ptr<const PacketT> packet)
+                channel->onPacket = [this, weakClient](std::unique_ptr<const PacketT> packet)
                 {
-                    // aqui lo que pasa es que tenemos que sacar el puntero crudo para pasarlo por la cola
-                    // si no entre en la cola lo eliminas para evitar fugas
-                    if (onPacketFromAnyChannel)
-                    {
-                        // FP_LOG_I("AGREG", "Paquete recibido en agregador con command %d", packet->command);
-                        const PacketT *raw_packet_ptr = packet.release();
-
-                        Core::PacketEnvelope<PacketT> envelope;
-                        envelope.channelId = myId;
-                        envelope.raw_packet_ptr = raw_packet_ptr;
+                    auto client = weakClient.lock();
+                    if (!client)
+                        return;
 
-                        bool enqueued = onPacketFromAnyChannel(envelope);
-                        if (!enqueued)
-                        {
-                            FP_LOG_W("AGREG", "Fallo al encolar paquete desde canal borramos ptr para evitar fuga");
-                            std::unique_ptr<const PacketT> failure_deleter(raw_packet_ptr);
-                        }
+                    // Si no cabe en la cola de entrada se libera al salir de aquí
+                    if (!client->ingress.tryPush(std::move(packet)))
+                    {
+                        client->dropped++;
+                        FP_LOG_D("AGREG", "Cola de entrada llena en canal %u, paquete descartado", client->id);
+                        return;
                     }
+
+                    doorbell_->set(kDoorbell);
                 };
+
+                return myId;
+            }
+
+            // Peso DRR del cliente: paquetes que puede entregar por ronda
+            void setChannelWeight(uint32_t channelId, uint32_t weight)
+            {
+                auto client = clients_.get(channelId);
+                if (client)
+                {
+                    client->weight.store(weight > 0 ? weight : 1);
+                }
+            }
+
+            // Paquetes perdidos por tener la cola de entrada llena
+            uint32_t getDroppedCount(uint32_t channelId)
+            {
+                auto client = clients_.get(channelId);
+                return client ? client->dropped.load() : 0;
+            }
+
+            void start()
+            {
+                if (isRunning_)
+                    return;
+
+                Core::OSAL::TaskConfig taskConfig;
+                taskConfig.name = "AgregPump";
+                taskConfig.stackSize = config_.stackSize;
+                taskConfig.priority = config_.priority;
+
+                isRunning_ = true;
+                pumpTask_ = Core::OSAL::Factory::createTask(
+                    [this]()
+                    { this->pumpLoop(); },
+                    taskConfig);
+
+                if (pumpTask_)
+                {
+                    pumpTask_->start();
+                }
+            }
+
+            void stop()
+            {
+                if (!isRunning_)
+                    return;
+
+                // Parada cooperativa: la bomba sale sola al despertar. Matarla (vTaskDelete)
+                // podría dejar una lectura del registro abierta para siempre
+                isRunning_ = false;
+                doorbell_->set(kDoorbell);
+                if (pumpTask_)
+                {
+                    pumpTask_->join();
+                }
             }
 
             void response(uint32_t responseId, std::unique_ptr<const PacketT> packet)
             {
-                channelsById_[responseId]->sendPacket(std::move(packet));
+                // Un id caducado (cliente cerrado o hueco reutilizado) no encuentra nada
+                auto client = clients_.get(responseId);
+                if (client)
+                {
+                    client->channel->sendPacket(std::move(packet));
+                }
+                else
+                {
+                    FP_LOG_D("AGREG", "Respuesta para canal %u ya cerrado, descartada", responseId);
+                }
+            }
+
+            using ChannelFilter = std::function<bool(uint32_t channelId)>;
+
+            /**
+             * @brief Encoder para broadcast(). Se comparte entre tareas, así que no debe
+             * guardar estado entre llamadas (MspEncoder no lo hace). Configurar antes de usar.
+             */
+            void setBroadcastEncoder(std::shared_ptr<Core::Protocol::IEncoderT<PacketT>> encoder)
+            {
+                broadcastEncoder_ = std::move(encoder);
+            }
+
+            /**
+             * @brief Envía el paquete a todos los clientes que acepte el filtro (todos si es nulo).
+             * Con encoder se codifica una vez; los canales que no aceptan tramas crudas
+             * reciben una copia del paquete. Los clientes con backpressure se saltan.
+             * @return Número de clientes a los que se ha enviado.
+             */
+            size_t broadcast(std::unique_ptr<const PacketT> packet, const ChannelFilter &filter = nullptr)
+            {
+                if (!packet)
+                    return 0;
+
+                Core::SharedFrame frame;
+                if (broadcastEncoder_)
+                {
+                    frame = Core::SharedFrame::fromVector(broadcastEncoder_->encodeFrom(*packet));
+                }
+                return fanOut(frame, packet.get(), filter);
+            }
+
+            /**
+             * @brief Igual que broadcast() pero con una trama ya codificada.
+             */
+            size_t broadcastFrame(const Core::SharedFrame &frame, const ChannelFilter &filter = nullptr)
+            {
+                if (!frame)
+                    return 0;
+                return fanOut(frame, nullptr, filter);
             }
 
-            std::function<bool(const Core::PacketEnvelope<PacketT> &)> onPacketFromAnyChannel;
+            // Debe devolver false si no acepta el paquete (p. ej. cola llena); en ese caso
+            // el paquete se reintenta más tarde.
+            // Si lo acepta debe quedarse con envelope.packet; si no, dejarlo en el sobre.
+            std::function<bool(Core::PacketEnvelope<PacketT> &)> onPacketFromAnyChannel;
+
+            static constexpr uint32_t kInvalidChannelId = 0;
 
         private:
-            std::atomic<uint32_t> nextChannelId_{1};
-            std::unique_ptr<Core::OSAL::IMutex> m_mutex;
-            std::map<uint32_t, std::shared_ptr<FlightProxy::Core::Channel::IChannelT<PacketT>>> channelsById_;
+            struct ClientState
+            {
+                ClientState(std::shared_ptr<FlightProxy::Core::Channel::IChannelT<PacketT>> ch,
+                            size_t depth, uint32_t w)
+                    : channel(std::move(ch)), ingress(depth), weight(w > 0 ? w : 1) {}
+
+                uint32_t id = kInvalidChannelId; // Se asigna al insertarlo en el registro
+                std::shared_ptr<FlightProxy::Core::Channel::IChannelT<PacketT>> channel;
+                // Un solo productor (la tarea RX del canal) y un solo consumidor (el bombeo)
+                Core::Utils::SpscRing<std::unique_ptr<const PacketT>> ingress;
+                std::atomic<uint32_t> weight;
+                std::atomic<uint32_t> dropped{0};
+                // Viaja en cada sobre: la cuota del cliente es suya, no de un hash del id
+                std::shared_ptr<Core::ClientCounters> counters = std::make_shared<Core::ClientCounters>();
+
+                // Solo los toca la tarea de bombeo
+                uint32_t deficit = 0;
+                bool credited = false;         // Ya recibió su quantum en esta visita
+                std::unique_ptr<const PacketT> held; // Paquete rechazado por el destino, pendiente de reintento
+            };
+
+            using Registry = Core::Utils::SlotMap<ClientState>;
+
+            size_t fanOut(const Core::SharedFrame &frame, const PacketT *packet, const ChannelFilter &filter)
+            {
+                typename Registry::Snapshot clients = clients_.snapshot();
+                size_t sent = 0;
+
+                for (const auto &slot : *clients)
+                {
+                    if (!slot.value || (filter && !filter(slot.value->id)))
+                        continue;
+
+                    auto &channel = slot.value->channel;
+                    if (channel->isCongested())
+                    {
+                        // Cliente lento: se salta esta difusión en lugar de crecerle la cola
+                        slot.value->dropped++;
+                        continue;
+                    }
+
+                    if (frame && channel->sendFrame(frame))
+                    {
+                        sent++;
+                    }
+                    else if (packet)
+                    {
+                        channel->sendPacket(std::unique_ptr<const PacketT>(new PacketT(*packet)));
+                        sent++;
+                    }
+                }
+                return sent;
+            }
+
+            // Entrega un paquete; false si el destino lo rechaza (se queda en 'held')
+            bool deliver(ClientState &client, std::unique_ptr<const PacketT> packet)
+            {
+                if (!onPacketFromAnyChannel)
+                    return true; // Sin consumidor: se descarta
+
+                Core::PacketEnvelope<PacketT> envelope;
+                envelope.channelId = client.id;
+                envelope.packet = std::move(packet);
+                envelope.client = client.counters;
+
+                if (!onPacketFromAnyChannel(envelope))
+                {
+                    client.held = std::move(envelope.packet);
+                    return false;
+                }
+                return true;
+            }
+
+            // Visita al cliente actual del DRR. Devuelve false si el destino rechaza su paquete.
+            bool serveClient(ClientState &client)
+            {
+                if (!client.credited)
+                {
+                    client.deficit += client.weight.load();
+                    client.credited = true;
+                }
+
+                while (client.deficit > 0)
+                {
+                    std::unique_ptr<const PacketT> packet = std::move(client.held);
+                    if (!packet && !client.ingress.tryPop(packet))
+                    {
+                        client.deficit = 0; // DRR: una cola vacía no acumula crédito
+                        break;
+                    }
+
+                    if (!deliver(client, std::move(packet)))
+                        return false; // Conserva el paquete y el crédito para el próximo intento
+
+                    client.deficit--;
+                }
+
+                client.credited = false;
+                return true;
+            }
+
+            void pumpLoop()
+            {
+                size_t cursor = 0;
+                bool blocked = false;
+
+                while (isRunning_)
+                {
+                    // Si el destino estaba lleno reintentamos pronto aunque no llegue nada nuevo
+                    doorbell_->waitAny(kDoorbell, blocked ? config_.retryMs : 1000);
+
+                    // Rondas DRR hasta que una vuelta completa no entregue nada: colas
+                    // vacías o el destino rechazando (p. ej. cuota del cliente o cola llena).
+                    blocked = false;
+                    size_t idle = 0;
+                    bool more = true;
+                    while (more && isRunning_)
+                    {
+                        // Una instantánea del registro por vuelta: un cliente cerrado a mitad
+                        // de vuelta sigue vivo hasta soltarla, y un insert/erase espera como
+                        // mucho una vuelta
+                        typename Registry::Snapshot clients = clients_.snapshot();
+                        const size_t size = clients->size();
+
+                        for (size_t visited = 0; visited < size && idle < size && isRunning_; ++visited)
+                        {
+                            cursor %= size;
+                            const auto &slot = (*clients)[cursor];
+
+                            if (!slot.value)
+                            {
+                                idle++; // Hueco libre
+                            }
+                            else if (!slot.value->held && slot.value->ingress.emptyApprox())
+                            {
+                                slot.value->deficit = 0;
+                                slot.value->credited = false;
+                                idle++;
+                            }
+                            else if (serveClient(*slot.value))
+                            {
+                                idle = 0;
+                            }
+                            else
+                            {
+                                blocked = true;
+                                idle++;
+                            }
+                            cursor++;
+                        }
+                        more = idle < size;
+                    }
+                }
+                FP_LOG_I("AGREG", "Tarea de bombeo finalizada");
+            }
+
+            ChannelAgregatorConfig config_;
+            Registry clients_;
+            std::shared_ptr<Core::Protocol::IEncoderT<PacketT>> broadcastEncoder_;
+
+            static constexpr Core::OSAL::IEventFlags::Bits kDoorbell = 1u << 0;
+            std::unique_ptr<Core::OSAL::IEventFlags> doorbell_;
+            std::unique_ptr<Core::OSAL::ITask> pumpTask_;
+            std::atomic<bool> isRunning_{false};
         };
 
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/OSAL/IExecutor.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Channel
+    {
+        struct ChannelConflatingConfig
+        {
+            bool conflateOutbound = true; // sendPacket(): al canal interno (p. ej. socket lento)
+            bool conflateInbound = false; // onPacket(): hacia un consumidor lento (necesita setExecutor)
+        };
+
+        /**
+         * @brief Decorador de canal que, para las claves configuradas, solo guarda el
+         * último paquete pendiente.
+         *
+         * Si el destino va más lento que el productor, el paquete pendiente se sustituye
+         * en su sitio en lugar de acumular cola: el consumidor siempre recibe el valor
+         * más reciente y la memoria es un paquete por clave y sentido. Los paquetes con
+         * claves no configuradas pasan directos y en orden.
+         *
+         * No tiene tarea propia. Lo de salida se vacía desde el contexto del que envía
+         * y, si el canal interno estaba congestionado, desde su onWritable. Lo de
+         * entrada se entrega en el executor compartido (setExecutor); sin executor la
+         * conflación de entrada no tiene dónde esperar y los paquetes pasan directos.
+         */
+        template <typename PacketT>
+        class ChannelConflatingT : public Core::Channel::IChannelT<PacketT>
+        {
+        public:
+            using KeyExtractor = std::function<uint32_t(const PacketT &)>;
+
+            ChannelConflatingT(std::shared_ptr<Core::Channel::IChannelT<PacketT>> inner,
+                               KeyExtractor extractor,
+                               const std::vector<uint32_t> &conflatedKeys,
+                               const ChannelConflatingConfig &config = ChannelConflatingConfig())
+                : inner_(std::move(inner)),
+                  extractor_(std::move(extractor)),
+                  config_(config),
+                  state_(std::make_shared<State>()),
+                  flushMutex_(Core::OSAL::Factory::createMutex("ChannelConflating.flush"))
+            {
+                // Los huecos se crean aquí: después no se añaden claves (memoria acotada)
+                for (uint32_t key : conflatedKeys)
+                {
+                    state_->slots[key];
+                }
+
+                state_->deliver = [this](std::unique_ptr<const PacketT> packet)
+                {
+                    if (this->onPacket)
+                        this->onPacket(std::move(packet));
+                };
+
+                inner_->onPacket = [this](std::unique_ptr<const PacketT> packet)
+                {
+                    if (config_.conflateInbound && executor_ && offer(packet, Direction::Inbound))
+                    {
+                        scheduleInbound();
+                        return;
+                    }
+                    if (this->onPacket)
+                        this->onPacket(std::move(packet));
+                };
+                inner_->onOpen = [this]()
+                {
+                    if (this->onOpen)
+                        this->onOpen();
+                };
+                inner_->onClose = [this]()
+                {
+                    if (this->onClose)
+                        this->onClose();
+                };
+                // Fin de la congestión: se envía lo que quedó retenido en los huecos
+                inner_->onWritable = [this]()
+                {
+                    flushOutbound();
+                    if (this->onWritable)
+                        this->onWritable();
+                };
+            }
+
+            ~ChannelConflatingT() override
+            {
+                inner_->onPacket = nullptr;
+                inner_->onOpen = nullptr;
+                inner_->onClose = nullptr;
+                inner_->onWritable = nullptr;
+
+                // Una entrega que ya esté en el executor termina antes de seguir; las que
+                // queden en cola encuentran deliver vacío y no tocan este objeto
+                std::lock_guard<Core::OSAL::IMutex> lock(*state_->deliverMutex);
+                state_->deliver = nullptr;
+            }
+
+            // Executor donde se entrega lo de entrada conflacionado. Antes de recibir tráfico.
+            void setExecutor(std::shared_ptr<Core::OSAL::IExecutor> executor)
+            {
+                executor_ = std::move(executor);
+            }
+
+            void open() override
+            {
+                inner_->open();
+            }
+
+            void close() override
+            {
+                inner_->close();
+            }
+
+            void sendPacket(std::unique_ptr<const PacketT> packet) override
+            {
+                if (config_.conflateOutbound && offer(packet, Direction::Outbound))
+                {
+                    flushOutbound();
+                    return;
+                }
+                inner_->sendPacket(std::move(packet));
+            }
+
+            bool sendFrame(const Core::SharedFrame &frame) override
+            {
+                return inner_->sendFrame(frame);
+            }
+
+            bool isCongested() const override { return inner_->isCongested(); }
+            size_t pendingTxBytes() const override { return inner_->pendingTxBytes(); }
+
+            // Paquetes sustituidos por uno más nuevo antes de salir (todas las claves)
+            uint32_t getReplacedCount() const { return replaced_.load(); }
+
+            // Paquetes sustituidos de una clave concreta
+            uint32_t getReplacedCount(uint32_t key) const
+            {
+                auto it = state_->slots.find(key);
+                return it != state_->slots.end() ? it->second.replaced.load() : 0;
+            }
+
+        private:
+            enum class Direction
+            {
+                Outbound,
+                Inbound
+            };
+
+            struct Slot
+            {
+                std::unique_ptr<const PacketT> outbound;
+                std::unique_ptr<const PacketT> inbound;
+                std::atomic<uint32_t> replaced{0};
+            };
+
+            // Lo que usan las entregas del executor: puede sobrevivir al decorador
+            struct State
+            {
+                std::unique_ptr<Core::OSAL::IMutex> mutex = Core::OSAL::Factory::createMutex("ChannelConflating");
+                std::map<uint32_t, Slot> slots; // Claves fijas desde el constructor
+                std::unique_ptr<Core::OSAL::IMutex> deliverMutex = Core::OSAL::Factory::createMutex("ChannelConflating.deliver");
+                std::function<void(std::unique_ptr<const PacketT>)> deliver;
+                std::atomic<bool> inboundScheduled{false};
+
+                void drainInbound()
+                {
+                    // Antes de sacar nada: lo que llegue a partir de aquí programa otra entrega
+                    inboundScheduled = false;
+
+                    std::lock_guard<Core::OSAL::IMutex> deliverLock(*deliverMutex);
+                    if (!deliver)
+                        return; // El decorador ya no existe
+
+                    for (auto &pair : slots)
+                    {
+                        std::unique_ptr<const PacketT> inbound;
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                            inbound = std::move(pair.second.inbound);
+                        }
+                        if (inbound)
+                            deliver(std::move(inbound));
+                    }
+                }
+            };
+
+            // Deja el paquete como pendiente de su clave. false si la clave no se conflaciona
+            // (el paquete sigue siendo del llamador).
+            bool offer(std::unique_ptr<const PacketT> &packet, Direction direction)
+            {
+                auto it = state_->slots.find(extractor_(*packet));
+                if (it == state_->slots.end())
+                    return false;
+
+                // Lo de salida puede quedarse en el hueco mientras el canal interno esté
+                // congestionado: copia propia para no retener el bloque de recepción
+                if (direction == Direction::Outbound && inner_->isCongested())
+                    packet.reset(new PacketT(Core::detachedCopy(*packet)));
+
+                std::unique_ptr<const PacketT> stale;
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*state_->mutex);
+                    auto &pending = (direction == Direction::Outbound) ? it->second.outbound : it->second.inbound;
+                    stale = std::move(pending);
+                    pending = std::move(packet);
+                }
+
+                if (stale)
+                {
+                    it->second.replaced++;
+                    replaced_++;
+                }
+                return true;
+            }
+
+            // Envía lo pendiente de salida hasta que el canal interno se congestione; lo
+            // que quede sigue sustituyéndose en su hueco hasta el próximo onWritable. El
+            // canal marca la congestión antes de avisar con onWritable, así que un
+            // paquete guardado tras la última comprobación siempre lo recoge alguien.
+            void flushOutbound()
+            {
+                // Un vaciado a la vez: dos paquetes de la misma clave nunca se adelantan
+                std::lock_guard<Core::OSAL::IMutex> flushLock(*flushMutex_);
+                for (auto &pair : state_->slots)
+                {
+                    if (inner_->isCongested())
+                        return;
+
+                    std::unique_ptr<const PacketT> outbound;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*state_->mutex);
+                        outbound = std::move(pair.second.outbound);
+                    }
+                    if (outbound)
+                        inner_->sendPacket(std::move(outbound));
+                }
+            }
+
+            // Una sola entrega de entrada en vuelo: mientras espera en el executor lo nuevo
+            // sigue sustituyendo en los huecos
+            void scheduleInbound()
+            {
+                if (state_->inboundScheduled.exchange(true))
+                    return;
+
+                std::weak_ptr<State> weakState = state_;
+                bool posted = executor_->post([weakState]()
+                                              {
+                                                  if (auto state = weakState.lock())
+                                                      state->drainInbound();
+                                              });
+                if (!posted)
+                {
+                    // Executor lleno: se entrega aquí antes que dejarlo en el hueco sin dueño
+                    state_->drainInbound();
+                }
+            }
+
+            std::shared_ptr<Core::Channel::IChannelT<PacketT>> inner_;
+            KeyExtractor extractor_;
+            ChannelConflatingConfig config_;
+            std::shared_ptr<State> state_;
+            std::unique_ptr<Core::OSAL::IMutex> flushMutex_;
+            std::shared_ptr<Core::OSAL::IExecutor> executor_;
+            std::atomic<uint32_t> replaced_{0};
+        };
+
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "FlightProxy/Core/Channel/IChannelT.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/Locks.h"
 #include "FlightProxy/Core/Utils/Logger.h"
 
 #include <functional> // Para std::function
@@ -10,6 +11,7 @@
 #include <vector>     // Para la lista de suscriptores por comando
 #include <algorithm>  // Para std::remove_if
 #include <mutex>      // Para std::lock_guard
+#include <shared_mutex> // Para std::shared_lock
 
 namespace FlightProxy
 {
@@ -97,7 +99,12 @@ namespace FlightProxy
             // Tabla de enrutamiento: Key = CommandId, Value = Lista de punteros DÉBILES
             std::map<CommandId, std::vector<std::weak_ptr<VirtualChannelT<PacketT>>>> m_routingTable;
 
-            std::unique_ptr<Core::OSAL::IMutex> m_routingMutex;
+            // Suscriptores que reciben todos los paquetes, sea cual sea su comando
+            std::vector<std::weak_ptr<VirtualChannelT<PacketT>>> m_catchAll;
+
+            // Cada paquete solo lee la tabla: los lectores no se bloquean entre sí
+            using RoutingMutex = Core::OSAL::TrackedLock<Core::OSAL::SharedMutex>;
+            RoutingMutex m_routingMutex{"Disgregator.routing"};
 
             std::atomic<bool> m_isClosed{true};
 
@@ -111,13 +118,13 @@ namespace FlightProxy
                 std::vector<std::shared_ptr<VirtualChannelT<PacketT>>> live_subscribers;
 
                 {
-                    // --- Sección Crítica ---
-                    std::lock_guard<Core::OSAL::IMutex> lock(*m_routingMutex);
+                    // --- Sección Crítica (lectura) ---
+                    std::shared_lock<RoutingMutex> lock(m_routingMutex);
 
                     auto it = m_routingTable.find(cmd);
                     if (it != m_routingTable.end())
                     {
-                        auto &subscribers = it->second; // Vector de weak_ptrs
+                        const auto &subscribers = it->second; // Vector de weak_ptrs
 
                         // Iteramos sobre los weak_ptr e intentamos "activarlos" (lock)
                         for (const auto &weak_sub : subscribers)
@@ -133,29 +140,24 @@ namespace FlightProxy
                                 needs_cleanup = true;
                             }
                         }
+                    }
 
-                        // Lógica de limpieza (si se marcó)
-                        if (needs_cleanup)
-                        {
-                            // "erase-remove idiom" para weak_ptrs expirados
-                            subscribers.erase(
-                                std::remove_if(subscribers.begin(), subscribers.end(),
-                                               [](const auto &p)
-                                               { return p.expired(); }),
-                                subscribers.end());
-
-                            FP_LOG_D("DemuxFactory", "Limpieza de suscriptores muertos para cmd %u", cmd);
-
-                            // Opcional: si el vector queda vacío, borramos la entrada
-                            if (subscribers.empty())
-                            {
-                                m_routingTable.erase(it);
-                            }
-                        }
+                    for (const auto &weak_sub : m_catchAll)
+                    {
+                        if (auto shared_sub = weak_sub.lock())
+                            live_subscribers.push_back(shared_sub);
+                        else
+                            needs_cleanup = true;
                     }
                     // --- Fin Sección Crítica ---
                 }
 
+                // Lógica de limpieza (si se marcó): es lo único que escribe, y es raro
+                if (needs_cleanup)
+                {
+                    removeExpired(cmd);
+                }
+
                 // 4. Despachar el paquete a la lista de VIVOS (fuera del mutex)
                 for (const auto &vChannel : live_subscribers)
                 {
@@ -163,12 +165,39 @@ namespace FlightProxy
                 }
             }
 
+            void removeExpired(CommandId cmd)
+            {
+                std::lock_guard<RoutingMutex> lock(m_routingMutex);
+
+                auto expired = [](const auto &p)
+                { return p.expired(); };
+
+                auto it = m_routingTable.find(cmd);
+                if (it != m_routingTable.end())
+                {
+                    // "erase-remove idiom" para weak_ptrs expirados
+                    auto &subscribers = it->second;
+                    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), expired),
+                                      subscribers.end());
+
+                    FP_LOG_D("DemuxFactory", "Limpieza de suscriptores muertos para cmd %u", cmd);
+
+                    // Opcional: si el vector queda vacío, borramos la entrada
+                    if (subscribers.empty())
+                    {
+                        m_routingTable.erase(it);
+                    }
+                }
+
+                m_catchAll.erase(std::remove_if(m_catchAll.begin(), m_catchAll.end(), expired),
+                                 m_catchAll.end());
+            }
+
         public:
             ChannelDisgregatorT(std::shared_ptr<Core::Channel::IChannelT<PacketT>> realChannel,
                                 CommandExtractor extractor)
                 : m_realChannel(realChannel),
-                  m_extractor(extractor),
-                  m_routingMutex(Core::OSAL::Factory::createMutex())
+                  m_extractor(extractor)
             {
                 if (!m_realChannel || !m_extractor)
                 {
@@ -191,7 +220,7 @@ namespace FlightProxy
                     std::vector<std::shared_ptr<VirtualChannelT<PacketT>>> all_live_subscribers;
 
                     {
-                        std::lock_guard<Core::OSAL::IMutex> lock(*m_routingMutex);
+                        std::lock_guard<RoutingMutex> lock(m_routingMutex);
 
                         for (const auto &pair : m_routingTable)
                         {
@@ -203,7 +232,15 @@ namespace FlightProxy
                                 }
                             }
                         }
+                        for (const auto &weak_vChan : m_catchAll)
+                        {
+                            if (auto shared_vChan = weak_vChan.lock())
+                            {
+                                all_live_subscribers.push_back(shared_vChan);
+                            }
+                        }
                         m_routingTable.clear();
+                        m_catchAll.clear();
                     }
 
                     for (const auto &vChannel : all_live_subscribers)
@@ -234,7 +271,7 @@ namespace FlightProxy
 
                 {
                     // --- Sección Crítica ---
-                    std::lock_guard<Core::OSAL::IMutex> lock(*m_routingMutex);
+                    std::lock_guard<RoutingMutex> lock(m_routingMutex);
 
                     // 2. Registrar un weak_ptr en nuestra tabla de enrutamiento
                     m_routingTable[responseIdToListenFor].push_back(
@@ -246,6 +283,24 @@ namespace FlightProxy
                 return std::static_pointer_cast<Core::Channel::IChannelT<PacketT>>(vChannel);
             }
 
+            /**
+             * @brief Canal virtual que recibe todos los paquetes del canal real
+             * (además de los suscriptores de cada comando). Útil para un passthrough.
+             */
+            std::shared_ptr<Core::Channel::IChannelT<PacketT>> createCatchAllChannel()
+            {
+                auto vChannel = std::make_shared<VirtualChannelT<PacketT>>(
+                    std::weak_ptr<ChannelDisgregatorT<PacketT>>(this->shared_from_this()),
+                    0);
+
+                {
+                    std::lock_guard<RoutingMutex> lock(m_routingMutex);
+                    m_catchAll.push_back(std::weak_ptr<VirtualChannelT<PacketT>>(vChannel));
+                }
+
+                return std::static_pointer_cast<Core::Channel::IChannelT<PacketT>>(vChannel);
+            }
+
             void sendPacketFromVirtual(std::unique_ptr<const PacketT> packet)
             {
                 // 1. Comprobamos la bandera atómica PRIMERO.
@@ -31,7 +31,7 @@ namespace FlightProxy
 
             ChannelPersistentT(TransportFactory tf, DecoderFactory df, EncoderFactory ef)
                 : m_tf(tf), m_df(df), m_ef(ef), m_running(false),
-                  m_mutex(Core::OSAL::Factory::createMutex())
+                  m_mutex(Core::OSAL::Factory::createMutex("ChannelPersistent"))
             {
                 if (!m_tf || !m_df || !m_ef)
                 {
@@ -0,0 +1,379 @@
+#pragma once
+
+#include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/Core/Utils/MpmcQueue.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Channel
+    {
+        struct TxLaneConfig
+        {
+            size_t depth = 8;        // Envíos en espera (se redondea a potencia de 2)
+            uint32_t weight = 1;     // Envíos por ronda en modo ponderado
+            bool dropOldest = false; // Con la cola llena se pierde el más antiguo (p. ej. RC)
+        };
+
+        struct ChannelPrioritizedConfig
+        {
+            // Carril 0 = más prioritario
+            std::vector<TxLaneConfig> lanes = std::vector<TxLaneConfig>(3);
+
+            // true: siempre se vacía antes el carril de menor índice.
+            // false: ronda ponderada (DRR) según 'weight' de cada carril.
+            bool strictPriority = true;
+
+            // Los carriles >= 1 solo sacan mientras el transporte tenga menos de esto sin
+            // enviar (más o menos una trama MSP). 0 = sin límite, hasta la congestión.
+            size_t inFlightBudgetBytes = 64;
+
+            uint32_t stackSize = 3072;
+            int priority = 4;
+        };
+
+        struct TxLaneStats
+        {
+            std::atomic<uint32_t> sent{0};
+            std::atomic<uint32_t> dropped{0};
+            std::atomic<uint64_t> waitSumMs{0}; // Tiempo en cola hasta que el transporte lo acepta
+            std::atomic<uint32_t> waitMaxMs{0};
+
+            uint32_t waitAvgMs() const
+            {
+                uint32_t count = sent.load();
+                return count ? static_cast<uint32_t>(waitSumMs.load() / count) : 0;
+            }
+        };
+
+        /**
+         * @brief Decorador de canal que ordena los envíos por carriles de prioridad.
+         *
+         * Los productores solo encolan (sin bloquear en el transporte); una tarea de
+         * transmisión elige el siguiente envío según la prioridad de carril. Para que esa
+         * elección valga de algo, los carriles >= 1 solo pasan al transporte mientras su
+         * cola de TX esté por debajo de inFlightBudgetBytes: una trama de RC espera como
+         * mucho ese presupuesto (y la trama que lo supere), no la cola entera del
+         * transporte. Lo demás espera en los carriles, y las estadísticas de espera miden
+         * esa cola real.
+         *
+         * Mientras el canal interno está congestionado (cola de TX del transporte por
+         * encima de la marca alta) la tarea deja de sacar también del carril 0, y sigue
+         * con onWritable.
+         */
+        template <typename PacketT>
+        class ChannelPrioritizedT : public Core::Channel::IChannelT<PacketT>
+        {
+        public:
+            // Devuelve el carril del paquete (fuera de rango = último carril)
+            using LaneClassifier = std::function<size_t(const PacketT &)>;
+
+            ChannelPrioritizedT(std::shared_ptr<Core::Channel::IChannelT<PacketT>> inner,
+                                LaneClassifier classifier,
+                                const ChannelPrioritizedConfig &config = ChannelPrioritizedConfig())
+                : inner_(std::move(inner)),
+                  classifier_(std::move(classifier)),
+                  config_(config),
+                  doorbell_(Core::OSAL::Factory::createEventFlags())
+            {
+                if (config_.lanes.empty())
+                    config_.lanes.resize(1);
+
+                for (const auto &laneConfig : config_.lanes)
+                {
+                    auto lane = std::make_unique<Lane>(laneConfig);
+                    lanes_.push_back(std::move(lane));
+                }
+
+                inner_->onPacket = [this](std::unique_ptr<const PacketT> packet)
+                {
+                    if (this->onPacket)
+                        this->onPacket(std::move(packet));
+                };
+                inner_->onOpen = [this]()
+                {
+                    if (this->onOpen)
+                        this->onOpen();
+                };
+                inner_->onClose = [this]()
+                {
+                    if (this->onClose)
+                        this->onClose();
+                };
+                // Fin de la congestión: la bomba vuelve a sacar de los carriles
+                inner_->onWritable = [this]()
+                {
+                    doorbell_->set(kDoorbell);
+                    if (this->onWritable)
+                        this->onWritable();
+                };
+
+                startPump();
+            }
+
+            ~ChannelPrioritizedT() override
+            {
+                stopPump();
+                inner_->onPacket = nullptr;
+                inner_->onOpen = nullptr;
+                inner_->onClose = nullptr;
+                inner_->onWritable = nullptr;
+            }
+
+            void open() override { inner_->open(); }
+            void close() override { inner_->close(); }
+
+            void sendPacket(std::unique_ptr<const PacketT> packet) override
+            {
+                size_t laneIndex = classifier_ ? classifier_(*packet) : lanes_.size() - 1;
+                TxItem item;
+                // Con el canal interno congestionado puede pasar tiempo en el carril: copia
+                // propia para no retener el bloque de recepción del que viene
+                if (inner_->isCongested())
+                    item.packet.reset(new PacketT(Core::detachedCopy(*packet)));
+                else
+                    item.packet = std::move(packet);
+                enqueue(laneIndex, std::move(item));
+            }
+
+            // Las tramas ya codificadas (difusión) van por el carril menos prioritario
+            bool sendFrame(const Core::SharedFrame &frame) override
+            {
+                TxItem item;
+                item.frame = frame;
+                enqueue(lanes_.size() - 1, std::move(item));
+                return true;
+            }
+
+            bool isCongested() const override { return inner_->isCongested(); }
+            size_t pendingTxBytes() const override { return inner_->pendingTxBytes(); }
+
+            const TxLaneStats &getLaneStats(size_t laneIndex) const
+            {
+                return lanes_[laneIndex < lanes_.size() ? laneIndex : lanes_.size() - 1]->stats;
+            }
+
+            size_t getLaneCount() const { return lanes_.size(); }
+
+        private:
+            struct TxItem
+            {
+                std::unique_ptr<const PacketT> packet;
+                Core::SharedFrame frame;
+                uint64_t enqueuedAtMs = 0;
+            };
+
+            struct Lane
+            {
+                explicit Lane(const TxLaneConfig &c)
+                    : config(c), queue(c.depth) {}
+
+                TxLaneConfig config;
+                Core::Utils::MpmcQueue<TxItem> queue;
+                TxLaneStats stats;
+                uint32_t deficit = 0; // Solo lo toca la tarea de transmisión
+            };
+
+            void enqueue(size_t laneIndex, TxItem item)
+            {
+                Lane &lane = *lanes_[laneIndex < lanes_.size() ? laneIndex : lanes_.size() - 1];
+                item.enqueuedAtMs = Core::OSAL::Factory::getSystemTimeMs();
+
+                if (!lane.queue.tryPush(std::move(item)))
+                {
+                    if (lane.config.dropOldest)
+                    {
+                        // Sacamos el más antiguo para hacer sitio al nuevo
+                        TxItem oldest;
+                        if (lane.queue.tryPop(oldest))
+                            lane.stats.dropped++;
+                        if (!lane.queue.tryPush(std::move(item)))
+                            lane.stats.dropped++;
+                    }
+                    else
+                    {
+                        lane.stats.dropped++;
+                    }
+                }
+
+                doorbell_->set(kDoorbell);
+            }
+
+            // Solo se llama con el canal interno sin congestión (ver pumpLoop): lo que
+            // entrega aquí lo acepta el transporte, y entonces cuenta como enviado
+            void transmit(Lane &lane, TxItem &item)
+            {
+                bool accepted = true;
+                if (item.packet)
+                {
+                    inner_->sendPacket(std::move(item.packet));
+                }
+                else if (item.frame)
+                {
+                    accepted = inner_->sendFrame(item.frame);
+                    item.frame.reset();
+                }
+
+                if (!accepted)
+                {
+                    lane.stats.dropped++;
+                    return;
+                }
+
+                uint64_t waitedMs = Core::OSAL::Factory::getSystemTimeMs() - item.enqueuedAtMs;
+                uint32_t waited = static_cast<uint32_t>(waitedMs);
+                lane.stats.sent++;
+                lane.stats.waitSumMs += waited;
+                uint32_t prev = lane.stats.waitMaxMs.load();
+                while (waited > prev && !lane.stats.waitMaxMs.compare_exchange_weak(prev, waited))
+                {
+                }
+            }
+
+            // El carril 0 solo se frena con la congestión; el resto, además, con el presupuesto
+            bool withinBudget(size_t laneIndex) const
+            {
+                if (laneIndex == 0 || config_.inFlightBudgetBytes == 0)
+                    return true;
+                return inner_->pendingTxBytes() < config_.inFlightBudgetBytes;
+            }
+
+            // Prioridad estricta: el primer carril con algo pendiente
+            bool serveStrict()
+            {
+                TxItem item;
+                for (size_t i = 0; i < lanes_.size(); ++i)
+                {
+                    Lane &lane = *lanes_[i];
+                    if (lane.queue.emptyApprox())
+                        continue;
+                    if (!withinBudget(i))
+                    {
+                        // Los carriles siguientes tienen el mismo presupuesto
+                        throttled_ = true;
+                        return false;
+                    }
+                    if (lane.queue.tryPop(item))
+                    {
+                        transmit(lane, item);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Ronda ponderada: cada carril envía hasta 'weight' por ronda
+            bool serveWeighted()
+            {
+                bool any = false;
+                TxItem item;
+                for (size_t i = 0; i < lanes_.size(); ++i)
+                {
+                    auto &lane = lanes_[i];
+                    if (!lane->queue.emptyApprox() && !withinBudget(i))
+                    {
+                        // Sin crédito mientras está frenado: al volver no sale de golpe
+                        throttled_ = true;
+                        continue;
+                    }
+                    lane->deficit += lane->config.weight > 0 ? lane->config.weight : 1;
+                    while (lane->deficit > 0 && !inner_->isCongested() && !lane->queue.emptyApprox())
+                    {
+                        if (!withinBudget(i))
+                        {
+                            throttled_ = true;
+                            break;
+                        }
+                        if (!lane->queue.tryPop(item))
+                            break;
+                        transmit(*lane, item);
+                        lane->deficit--;
+                        any = true;
+                    }
+                    if (lane->queue.emptyApprox())
+                        lane->deficit = 0; // Un carril vacío no acumula crédito
+                }
+                return any;
+            }
+
+            void startPump()
+            {
+                Core::OSAL::TaskConfig taskConfig;
+                taskConfig.name = "PrioTx";
+                taskConfig.stackSize = config_.stackSize;
+                taskConfig.priority = config_.priority;
+
+                isRunning_ = true;
+                pumpTask_ = Core::OSAL::Factory::createTask(
+                    [this]()
+                    { this->pumpLoop(); },
+                    taskConfig);
+
+                if (pumpTask_)
+                {
+                    pumpTask_->start();
+                }
+            }
+
+            void stopPump()
+            {
+                if (!isRunning_)
+                    return;
+
+                // Parada cooperativa: matar la bomba (vTaskDelete) podría dejarla a medias
+                // dentro del transporte, con su mutex o una reserva de heap cogidos
+                isRunning_ = false;
+                doorbell_->set(kDoorbell);
+                if (pumpTask_)
+                {
+                    pumpTask_->join();
+                }
+            }
+
+            void pumpLoop()
+            {
+                while (isRunning_)
+                {
+                    // Frenados por el presupuesto no hay aviso de cuándo se vacía el
+                    // transporte: se vuelve a mirar al siguiente tick
+                    doorbell_->waitAny(kDoorbell, throttled_ ? kThrottlePollMs : 1000);
+                    throttled_ = false;
+
+                    if (config_.strictPriority)
+                    {
+                        while (isRunning_ && !inner_->isCongested() && serveStrict())
+                        {
+                        }
+                    }
+                    else
+                    {
+                        while (isRunning_ && !inner_->isCongested() && serveWeighted())
+                        {
+                        }
+                    }
+                }
+                FP_LOG_I("PrioTx", "Tarea de transmisión finalizada");
+            }
+
+            std::shared_ptr<Core::Channel::IChannelT<PacketT>> inner_;
+            LaneClassifier classifier_;
+            ChannelPrioritizedConfig config_;
+            std::vector<std::unique_ptr<Lane>> lanes_;
+
+            static constexpr Core::OSAL::IEventFlags::Bits kDoorbell = 1u << 0;
+            std::unique_ptr<Core::OSAL::IEventFlags> doorbell_;
+            std::unique_ptr<Core::OSAL::ITask> pumpTask_;
+            std::atomic<bool> isRunning_{false};
+
+            static constexpr uint32_t kThrottlePollMs = 1;
+            bool throttled_ = false; // Solo lo toca la tarea de transmisión
+        };
+
+    }
+}
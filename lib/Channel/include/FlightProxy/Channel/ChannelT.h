@@ -4,6 +4,7 @@
 #include "FlightProxy/Core/Transport/ITransport.h"
 #include "FlightProxy/Core/Protocol/IEncoderT.h"
 #include "FlightProxy/Core/Protocol/IDecoderT.h"
+#include <atomic>
 #include <memory>
 
 namespace FlightProxy
@@ -32,6 +33,14 @@ namespace FlightProxy
                             decoder_->feed(data, len);
                         }
                     };
+                    // Transportes con bloques de recepción: los paquetes pueden apuntar al bloque
+                    transport_ptr->onChunk = [this](const Core::Utils::ByteView &chunk)
+                    {
+                        if (decoder_)
+                        {
+                            decoder_->feedChunk(chunk);
+                        }
+                    };
                     transport_ptr->onOpen = [this]()
                     {
                         if (this->onOpen)
@@ -47,6 +56,20 @@ namespace FlightProxy
                             this->onClose();
                         }
                     };
+
+                    // Backpressure del transporte: quien envía puede consultar isCongested()
+                    transport_ptr->onBackpressure = [this]()
+                    {
+                        congested_.store(true);
+                    };
+                    transport_ptr->onWritable = [this]()
+                    {
+                        congested_.store(false);
+                        if (this->onWritable)
+                        {
+                            this->onWritable();
+                        }
+                    };
                 }
 
                 decoder_->onPacket([this](std::unique_ptr<const PacketT> packet)
@@ -80,16 +103,63 @@ namespace FlightProxy
             {
                 if (auto transport_ptr = transport_.lock())
                 {
+                    // Si el paquete conserva su trama original se reenvía sin recodificar.
+                    // Con la cola congestionada se copia: así no retiene el bloque de
+                    // recepción de otro transporte mientras espera
+                    if (const Core::SharedFrame *raw = Core::rawFrameOf(*packet))
+                    {
+                        if (congested_.load())
+                            transport_ptr->trySend(raw->data(), raw->size());
+                        else
+                            transport_ptr->trySendFrame(*raw);
+                        return;
+                    }
+
+                    // Trama en trozos: el payload sale de su almacenamiento sin aplanarlo antes
+                    uint8_t scratch[Core::Protocol::kGatherScratchBytes];
+                    Core::Transport::IoSlice slices[Core::Protocol::kMaxGatherSlices];
+                    size_t count = encoder_->encodeGather(*packet, scratch, slices);
+                    if (count > 0)
+                    {
+                        transport_ptr->trySendv(slices, count);
+                        return;
+                    }
+
                     // FP_LOG_D("ChannelT", "Codificando y enviando paquete desde ChannelT");
                     std::vector<uint8_t> encodedData = encoder_->encode(std::move(packet));
-                    transport_ptr->send(encodedData.data(), encodedData.size());
+                    transport_ptr->trySend(encodedData.data(), encodedData.size());
+                }
+            }
+
+            bool sendFrame(const Core::SharedFrame &frame) override
+            {
+                if (!frame)
+                    return true;
+
+                if (auto transport_ptr = transport_.lock())
+                {
+                    // Cada cliente encola la misma trama, sin copiarla
+                    transport_ptr->trySendFrame(frame);
                 }
+                return true;
+            }
+
+            bool isCongested() const override
+            {
+                return congested_.load();
+            }
+
+            size_t pendingTxBytes() const override
+            {
+                auto transport_ptr = transport_.lock();
+                return transport_ptr ? transport_ptr->pendingTxBytes() : 0;
             }
 
         private:
             std::weak_ptr<Core::Transport::ITransport> transport_;
             std::shared_ptr<Core::Protocol::IEncoderT<PacketT>> encoder_;
             std::shared_ptr<Core::Protocol::IDecoderT<PacketT>> decoder_;
+            std::atomic<bool> congested_{false};
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,394 @@
+#pragma once
+
+#include "FlightProxy/Core/Coro/CoTask.h"
+
+#if FP_HAS_COROUTINES
+
+#include "FlightProxy/Channel/ChannelDisgregatorT.h" // Para CommandId
+#include "FlightProxy/Core/Channel/IChannelT.h"
+#include "FlightProxy/Core/OSAL/IExecutor.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Channel
+    {
+        enum class RequestStatus : uint8_t
+        {
+            Ok,        // Llegó la respuesta
+            Timeout,   // No llegó a tiempo
+            Cancelled, // cancelAll() o se destruyó el requester
+            Closed,    // El canal se cerró
+            Busy       // No quedaban huecos para peticiones en vuelo
+        };
+
+        template <typename PacketT>
+        struct RequestResult
+        {
+            RequestStatus status = RequestStatus::Cancelled;
+            std::unique_ptr<const PacketT> packet; // Solo con status Ok
+
+            explicit operator bool() const { return status == RequestStatus::Ok; }
+            const PacketT *operator->() const { return packet.get(); }
+            const PacketT &operator*() const { return *packet; }
+        };
+
+        struct RequesterStats
+        {
+            std::atomic<uint32_t> requests{0};
+            std::atomic<uint32_t> replies{0};
+            std::atomic<uint32_t> timeouts{0};
+            std::atomic<uint32_t> busy{0};
+            std::atomic<uint32_t> unmatched{0}; // Respuestas sin petición (llegaron tarde)
+        };
+
+        /**
+         * @brief Peticiones/respuestas sobre un canal con co_await.
+         *
+         *   auto reply = co_await fc.request(Core::Protocol::MSP_IMU_DATA, 200);
+         *   if (reply)
+         *       procesar(reply->payload);
+         *
+         * La corrutina se suspende hasta que llega la respuesta o vence el timeout
+         * (un temporizador del TimerService); ninguna tarea queda bloqueada
+         * esperando. Se reanuda en el executor si hay uno (setExecutor), o si no en
+         * la tarea que entrega la respuesta o en la de los temporizadores.
+         *
+         * Una respuesta se empareja con la petición más antigua en vuelo del mismo
+         * comando (MSP no lleva número de secuencia). Las peticiones en vuelo van en
+         * una tabla fija de maxPending huecos; si está llena la petición vuelve al
+         * momento con Busy.
+         *
+         * Se queda con onPacket y onClose del canal: usar un canal virtual propio
+         * (ChannelDisgregatorT::createVirtualChannel o createCatchAllChannel).
+         *
+         * Al destruirse cancela las peticiones en vuelo (Cancelled): la corrutina
+         * que las esperaba se reanuda y debe salir sin tocar al dueño del requester
+         * si este se está destruyendo.
+         */
+        template <typename PacketT>
+        class RequesterT
+        {
+        public:
+            using CommandExtractor = std::function<CommandId(const PacketT &)>;
+            using RequestFactory = std::function<std::unique_ptr<const PacketT>(CommandId)>;
+            using Result = RequestResult<PacketT>;
+
+        private:
+            struct Shared;
+
+        public:
+            class Awaiter
+            {
+            public:
+                bool await_ready() const noexcept { return m_ready; }
+
+                bool await_suspend(std::coroutine_handle<> handle)
+                {
+                    // Copia local: si la respuesta llega antes de volver, el awaiter
+                    // (que vive en el marco de la corrutina) puede haber desaparecido
+                    std::shared_ptr<Shared> shared = m_shared;
+                    return shared->begin(*this, handle);
+                }
+
+                Result await_resume() { return std::move(m_result); }
+
+            private:
+                friend class RequesterT;
+
+                Awaiter(std::shared_ptr<Shared> shared, std::unique_ptr<const PacketT> packet, uint32_t timeoutMs)
+                    : m_shared(std::move(shared)), m_packet(std::move(packet)), m_timeoutMs(timeoutMs)
+                {
+                }
+
+                explicit Awaiter(RequestStatus status) : m_ready(true)
+                {
+                    m_result.status = status;
+                }
+
+                std::shared_ptr<Shared> m_shared;
+                std::unique_ptr<const PacketT> m_packet;
+                uint32_t m_timeoutMs = 0;
+                bool m_ready = false;
+                Result m_result;
+            };
+
+            // Construye la petición para request(command, timeoutMs)
+            RequestFactory requestFactory;
+
+            RequesterT(std::shared_ptr<Core::Channel::IChannelT<PacketT>> channel,
+                       CommandExtractor extractor,
+                       std::shared_ptr<Core::OSAL::TimerService> timers,
+                       size_t maxPending = 8)
+                : m_shared(std::make_shared<Shared>(std::move(channel), std::move(extractor), std::move(timers), maxPending))
+            {
+                std::weak_ptr<Shared> weakShared = m_shared;
+                m_shared->channel->onPacket = [weakShared](std::unique_ptr<const PacketT> pkt)
+                {
+                    if (auto shared = weakShared.lock())
+                        shared->onReply(std::move(pkt));
+                };
+                m_shared->channel->onClose = [weakShared]()
+                {
+                    if (auto shared = weakShared.lock())
+                    {
+                        shared->closed.store(true);
+                        shared->finishAll(RequestStatus::Closed);
+                    }
+                };
+            }
+
+            ~RequesterT()
+            {
+                m_shared->channel->onPacket = nullptr;
+                m_shared->channel->onClose = nullptr;
+                m_shared->finishAll(RequestStatus::Cancelled);
+            }
+
+            RequesterT(const RequesterT &) = delete;
+            RequesterT &operator=(const RequesterT &) = delete;
+
+            // Antes de la primera petición
+            void setExecutor(std::shared_ptr<Core::OSAL::IExecutor> executor)
+            {
+                m_shared->executor = std::move(executor);
+            }
+
+            Awaiter request(std::unique_ptr<const PacketT> packet, uint32_t timeoutMs)
+            {
+                if (!packet)
+                    return Awaiter(RequestStatus::Cancelled);
+                if (m_shared->closed.load())
+                    return Awaiter(RequestStatus::Closed);
+                return Awaiter(m_shared, std::move(packet), timeoutMs);
+            }
+
+            Awaiter request(CommandId command, uint32_t timeoutMs)
+            {
+                if (!requestFactory)
+                {
+                    FP_LOG_E("Requester", "request(%u) sin requestFactory", command);
+                    return Awaiter(RequestStatus::Cancelled);
+                }
+                return request(requestFactory(command), timeoutMs);
+            }
+
+            // Reanuda con Cancelled todas las peticiones en vuelo; devuelve cuántas
+            size_t cancelAll()
+            {
+                return m_shared->finishAll(RequestStatus::Cancelled);
+            }
+
+            size_t pendingCount() const
+            {
+                std::lock_guard<Core::OSAL::IMutex> lock(*m_shared->mutex);
+                size_t count = 0;
+                for (const auto &slot : m_shared->slots)
+                {
+                    if (slot.used)
+                        ++count;
+                }
+                return count;
+            }
+
+            const RequesterStats &getStats() const { return m_shared->stats; }
+
+        private:
+            struct Slot
+            {
+                bool used = false;
+                uint16_t generation = 0; // Cambia en cada uso: un timeout viejo no toca al siguiente
+                CommandId command = 0;
+                uint32_t order = 0;      // Para emparejar con la más antigua
+                std::coroutine_handle<> handle;
+                Result *result = nullptr; // Dentro del Awaiter, en el marco suspendido
+                Core::OSAL::TimerService::TimerId timer = Core::OSAL::TimerService::kInvalidTimer;
+            };
+
+            /**
+             * @brief Estado compartido con los callbacks del canal y de los
+             * temporizadores, que pueden llegar después de destruir el requester.
+             */
+            struct Shared : std::enable_shared_from_this<Shared>
+            {
+                std::shared_ptr<Core::Channel::IChannelT<PacketT>> channel;
+                CommandExtractor extractor;
+                std::shared_ptr<Core::OSAL::TimerService> timers;
+                std::shared_ptr<Core::OSAL::IExecutor> executor;
+                std::unique_ptr<Core::OSAL::IMutex> mutex = Core::OSAL::Factory::createMutex("Requester");
+                std::vector<Slot> slots;
+                uint32_t nextOrder = 0;
+                std::atomic<bool> closed{false};
+                RequesterStats stats;
+
+                Shared(std::shared_ptr<Core::Channel::IChannelT<PacketT>> ch, CommandExtractor ex,
+                       std::shared_ptr<Core::OSAL::TimerService> tm, size_t maxPending)
+                    : channel(std::move(ch)), extractor(std::move(ex)), timers(std::move(tm)),
+                      slots(maxPending ? maxPending : 1)
+                {
+                }
+
+                /**
+                 * @brief Registra la petición y la envía.
+                 * @return false si terminó sin suspender (Busy); el resultado ya está
+                 * en el awaiter.
+                 */
+                bool begin(Awaiter &awaiter, std::coroutine_handle<> handle)
+                {
+                    // Todo lo que hace falta del awaiter se saca antes de publicar el
+                    // hueco: desde ese momento la corrutina puede reanudarse en otro hilo
+                    std::unique_ptr<const PacketT> packet = std::move(awaiter.m_packet);
+                    uint64_t timeoutUs = static_cast<uint64_t>(awaiter.m_timeoutMs) * 1000;
+                    CommandId command = extractor(*packet);
+
+                    size_t index = slots.size();
+                    uint16_t generation = 0;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                        for (size_t i = 0; i < slots.size(); ++i)
+                        {
+                            if (!slots[i].used)
+                            {
+                                index = i;
+                                break;
+                            }
+                        }
+                        if (index == slots.size())
+                        {
+                            stats.busy++;
+                            awaiter.m_result.status = RequestStatus::Busy;
+                            return false;
+                        }
+                        Slot &slot = slots[index];
+                        slot.used = true;
+                        generation = ++slot.generation;
+                        slot.command = command;
+                        slot.order = nextOrder++;
+                        slot.handle = handle;
+                        slot.result = &awaiter.m_result;
+                        slot.timer = Core::OSAL::TimerService::kInvalidTimer;
+                    }
+                    stats.requests++;
+
+                    std::weak_ptr<Shared> weakSelf = this->shared_from_this();
+                    auto timer = timers->scheduleOnce(timeoutUs, [weakSelf, index, generation]()
+                                                      {
+                        if (auto self = weakSelf.lock())
+                        {
+                            if (self->finish(index, generation, RequestStatus::Timeout, nullptr))
+                                self->stats.timeouts++;
+                        } });
+
+                    bool stillPending = false;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                        Slot &slot = slots[index];
+                        if (slot.used && slot.generation == generation)
+                        {
+                            slot.timer = timer;
+                            stillPending = true;
+                        }
+                    }
+                    // Ya terminó (respuesta o cierre) antes de guardar el temporizador
+                    if (!stillPending)
+                        timers->cancel(timer);
+                    else if (timer == Core::OSAL::TimerService::kInvalidTimer)
+                        FP_LOG_W("Requester", "Sin temporizadores libres: la petición %u no caduca", command);
+
+                    channel->sendPacket(std::move(packet));
+                    return true;
+                }
+
+                void onReply(std::unique_ptr<const PacketT> pkt)
+                {
+                    CommandId command = extractor(*pkt);
+                    size_t index = slots.size();
+                    uint16_t generation = 0;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                        for (size_t i = 0; i < slots.size(); ++i)
+                        {
+                            const Slot &slot = slots[i];
+                            if (slot.used && slot.command == command &&
+                                (index == slots.size() || static_cast<int32_t>(slot.order - slots[index].order) < 0))
+                                index = i;
+                        }
+                        if (index != slots.size())
+                            generation = slots[index].generation;
+                    }
+
+                    if (index == slots.size() || !finish(index, generation, RequestStatus::Ok, std::move(pkt)))
+                    {
+                        stats.unmatched++;
+                        return;
+                    }
+                    stats.replies++;
+                }
+
+                /**
+                 * @brief Cierra el hueco con un resultado y reanuda su corrutina.
+                 * Gana el primero (respuesta, timeout o cancelación) que lo reclama.
+                 */
+                bool finish(size_t index, uint16_t generation, RequestStatus status, std::unique_ptr<const PacketT> pkt)
+                {
+                    std::coroutine_handle<> handle;
+                    Core::OSAL::TimerService::TimerId timer;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                        Slot &slot = slots[index];
+                        if (!slot.used || slot.generation != generation)
+                            return false;
+                        slot.result->status = status;
+                        slot.result->packet = std::move(pkt);
+                        handle = slot.handle;
+                        timer = slot.timer;
+                        slot.used = false;
+                        slot.handle = nullptr;
+                        slot.result = nullptr;
+                    }
+
+                    if (status != RequestStatus::Timeout && timer != Core::OSAL::TimerService::kInvalidTimer)
+                        timers->cancel(timer);
+                    Core::Coro::resumeOn(executor.get(), handle);
+                    return true;
+                }
+
+                size_t finishAll(RequestStatus status)
+                {
+                    std::vector<std::pair<size_t, uint16_t>> claimed;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex);
+                        for (size_t i = 0; i < slots.size(); ++i)
+                        {
+                            if (slots[i].used)
+                                claimed.emplace_back(i, slots[i].generation);
+                        }
+                    }
+                    size_t count = 0;
+                    for (const auto &entry : claimed)
+                    {
+                        if (finish(entry.first, entry.second, status, nullptr))
+                            ++count;
+                    }
+                    return count;
+                }
+            };
+
+            std::shared_ptr<Shared> m_shared;
+        };
+
+    } // namespace Channel
+} // namespace FlightProxy
+
+#endif
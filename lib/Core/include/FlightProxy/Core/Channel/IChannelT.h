@@ -1,5 +1,7 @@
 #pragma once
+#include "FlightProxy/Core/FlightProxyTypes.h"
 #include <functional>
+#include <memory>
 
 namespace FlightProxy
 {
@@ -17,10 +19,22 @@ namespace FlightProxy
                 virtual void close() = 0;
                 virtual void sendPacket(std::unique_ptr<const PacketT> packet) = 0;
 
+                // Envía una trama ya codificada. Devuelve false si el canal no sabe
+                // enviar bytes crudos; entonces el llamante debe usar sendPacket().
+                virtual bool sendFrame(const Core::SharedFrame &) { return false; }
+
+                // true mientras el transporte tiene la cola de TX por encima de la marca alta
+                virtual bool isCongested() const { return false; }
+
+                // Bytes aceptados por el transporte que todavía no han salido
+                virtual size_t pendingTxBytes() const { return 0; }
+
                 // Callbacks que el usuario (dueño del channel) puede suscribir
                 std::function<void(std::unique_ptr<const PacketT>)> onPacket;
                 std::function<void()> onOpen;
                 std::function<void()> onClose;
+                // Fin de la congestión (isCongested() vuelve a false): se puede seguir enviando
+                std::function<void()> onWritable;
             };
         }
     }
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/IBlockPool.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Coro
+        {
+            struct CoFramePoolStats
+            {
+                uint32_t pooled = 0;   // Marcos servidos desde un pool
+                uint32_t heap = 0;     // Marcos que no cabían o sin bloque libre (heap)
+                size_t inUse = 0;      // Bloques de pool en uso ahora mismo
+                size_t highWatermark = 0;
+            };
+
+            /**
+             * @brief Memoria para los marcos de las corrutinas (ver CoTask).
+             *
+             * Unas pocas clases de tamaño, cada una un IBlockPool creado con la Factory
+             * la primera vez que se usa. Un marco va al bloque más pequeño en el que
+             * cabe; si es más grande que todos o su clase está agotada, va al heap (como
+             * PoolAllocator) y se cuenta en 'heap' para poder ajustar las capacidades.
+             */
+            class CoFramePool
+            {
+            public:
+                static constexpr size_t kClassCount = 4;
+                static constexpr size_t kBlockSizes[kClassCount] = {128, 256, 512, 1024};
+                static constexpr size_t kBlockCounts[kClassCount] = {16, 16, 8, 4};
+
+                static CoFramePool &instance()
+                {
+                    static CoFramePool pool;
+                    return pool;
+                }
+
+                void *allocate(size_t size)
+                {
+                    for (size_t i = 0; i < kClassCount; ++i)
+                    {
+                        if (size <= kBlockSizes[i] && pools_[i])
+                        {
+                            if (void *block = pools_[i]->allocate())
+                            {
+                                pooled_.fetch_add(1, std::memory_order_relaxed);
+                                return block;
+                            }
+                        }
+                    }
+                    heap_.fetch_add(1, std::memory_order_relaxed);
+                    return ::operator new(size);
+                }
+
+                void deallocate(void *ptr)
+                {
+                    for (auto &pool : pools_)
+                    {
+                        if (pool && pool->owns(ptr))
+                        {
+                            pool->deallocate(ptr);
+                            return;
+                        }
+                    }
+                    ::operator delete(ptr);
+                }
+
+                CoFramePoolStats getStats() const
+                {
+                    CoFramePoolStats stats;
+                    stats.pooled = pooled_.load(std::memory_order_relaxed);
+                    stats.heap = heap_.load(std::memory_order_relaxed);
+                    for (const auto &pool : pools_)
+                    {
+                        if (!pool)
+                            continue;
+                        OSAL::BlockPoolStats poolStats = pool->getStats();
+                        stats.inUse += poolStats.inUse;
+                        stats.highWatermark += poolStats.highWatermark;
+                    }
+                    return stats;
+                }
+
+            private:
+                CoFramePool()
+                {
+                    for (size_t i = 0; i < kClassCount; ++i)
+                        pools_[i] = OSAL::Factory::createBlockPool(kBlockSizes[i], kBlockCounts[i]);
+                }
+
+                std::unique_ptr<OSAL::IBlockPool> pools_[kClassCount];
+                std::atomic<uint32_t> pooled_{0};
+                std::atomic<uint32_t> heap_{0};
+            };
+        }
+    }
+}
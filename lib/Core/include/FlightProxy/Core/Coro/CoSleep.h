@@ -0,0 +1,58 @@
+#pragma once
+
+#include "FlightProxy/Core/Coro/CoTask.h"
+
+#if FP_HAS_COROUTINES
+
+#include "FlightProxy/Core/OSAL/IExecutor.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+
+#include <coroutine>
+#include <cstdint>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Coro
+        {
+            /**
+             * @brief co_await sleepFor(timers, ms): suspende la corrutina sin ocupar
+             * ninguna tarea. La reanuda el TimerService (o el executor, si se pasa).
+             * Si no quedan temporizadores libres, sigue sin esperar.
+             */
+            class SleepAwaiter
+            {
+            public:
+                SleepAwaiter(OSAL::TimerService &timers, uint32_t ms, OSAL::IExecutor *executor)
+                    : timers_(timers), ms_(ms), executor_(executor)
+                {
+                }
+
+                bool await_ready() const noexcept { return ms_ == 0; }
+
+                bool await_suspend(std::coroutine_handle<> handle)
+                {
+                    OSAL::IExecutor *executor = executor_;
+                    auto id = timers_.scheduleOnce(static_cast<uint64_t>(ms_) * 1000, [executor, handle]()
+                                                   { resumeOn(executor, handle); });
+                    return id != OSAL::TimerService::kInvalidTimer;
+                }
+
+                void await_resume() const noexcept {}
+
+            private:
+                OSAL::TimerService &timers_;
+                uint32_t ms_;
+                OSAL::IExecutor *executor_;
+            };
+
+            inline SleepAwaiter sleepFor(OSAL::TimerService &timers, uint32_t ms, OSAL::IExecutor *executor = nullptr)
+            {
+                return SleepAwaiter(timers, ms, executor);
+            }
+        }
+    }
+}
+
+#endif
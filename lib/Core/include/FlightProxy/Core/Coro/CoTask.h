@@ -0,0 +1,238 @@
+#pragma once
+
+// Capa de corrutinas (C++20). Con un estándar anterior estas cabeceras quedan
+// vacías y FP_HAS_COROUTINES no se define: el código que las use debe ir dentro
+// de #if FP_HAS_COROUTINES.
+//
+//   Coro::CoTask<void> ciclo(std::shared_ptr<Nodo> self)
+//   {
+//       auto reply = co_await self->fc.request(MSP_IMU_DATA, 200);
+//       if (!reply)
+//           co_return;
+//       ...
+//   }
+//
+//   ciclo(shared_from_this()).detach(); // Arranca y se libera sola al acabar
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define FP_HAS_COROUTINES 1
+
+#include "FlightProxy/Core/Coro/CoFramePool.h"
+#include "FlightProxy/Core/OSAL/IExecutor.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Coro
+        {
+            /**
+             * @brief Reanuda una corrutina suspendida: en el executor si hay uno, o
+             * aquí mismo si no hay o ya está parado.
+             */
+            inline void resumeOn(OSAL::IExecutor *executor, std::coroutine_handle<> handle)
+            {
+                if (executor && executor->post([handle]()
+                                               { handle.resume(); }))
+                    return;
+                handle.resume();
+            }
+
+            namespace Detail
+            {
+                struct PromiseBase
+                {
+                    std::coroutine_handle<> continuation; // Quien hace co_await de esta tarea
+                    bool detached = false;
+
+                    // Los marcos salen del CoFramePool: sin heap en el caso normal
+                    static void *operator new(size_t size)
+                    {
+                        return CoFramePool::instance().allocate(size);
+                    }
+
+                    static void operator delete(void *ptr, size_t)
+                    {
+                        CoFramePool::instance().deallocate(ptr);
+                    }
+
+                    std::suspend_always initial_suspend() noexcept { return {}; }
+
+                    struct FinalAwaiter
+                    {
+                        bool await_ready() noexcept { return false; }
+
+                        template <typename Promise>
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                        {
+                            PromiseBase &promise = handle.promise();
+                            if (promise.continuation)
+                                return promise.continuation; // Transferencia simétrica: sin crecer la pila
+                            if (promise.detached)
+                                handle.destroy();
+                            return std::noop_coroutine();
+                        }
+
+                        void await_resume() noexcept {}
+                    };
+
+                    FinalAwaiter final_suspend() noexcept { return {}; }
+
+                    // El proyecto no usa excepciones en la lógica: una que escape es un bug
+                    void unhandled_exception() noexcept { std::terminate(); }
+                };
+            }
+
+            /**
+             * @brief Tarea asíncrona perezosa: no empieza hasta que alguien hace
+             * co_await de ella o se llama a detach().
+             *
+             * - co_await tarea: la corrutina padre se suspende y continúa cuando la
+             *   hija acaba, en el mismo hilo en el que acabó la hija.
+             * - detach(): la arranca sin esperarla; el marco se libera solo al acabar.
+             *
+             * Se suspende en los awaiters de E/S (ver RequesterT, sleepFor), nunca
+             * bloquea la tarea que la ejecuta.
+             */
+            template <typename T = void>
+            class CoTask
+            {
+            public:
+                struct promise_type : Detail::PromiseBase
+                {
+                    std::optional<T> value;
+
+                    CoTask get_return_object() { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+                    template <typename U>
+                    void return_value(U &&result) { value.emplace(std::forward<U>(result)); }
+                };
+
+                CoTask(CoTask &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+                CoTask &operator=(CoTask &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        handle_ = std::exchange(other.handle_, nullptr);
+                    }
+                    return *this;
+                }
+                CoTask(const CoTask &) = delete;
+                CoTask &operator=(const CoTask &) = delete;
+
+                ~CoTask() { reset(); }
+
+                auto operator co_await() && noexcept
+                {
+                    struct Awaiter
+                    {
+                        std::coroutine_handle<promise_type> handle;
+
+                        bool await_ready() noexcept { return !handle || handle.done(); }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept
+                        {
+                            handle.promise().continuation = parent;
+                            return handle;
+                        }
+
+                        T await_resume() { return std::move(*handle.promise().value); }
+                    };
+                    return Awaiter{handle_};
+                }
+
+                void detach() &&
+                {
+                    auto handle = std::exchange(handle_, nullptr);
+                    handle.promise().detached = true;
+                    handle.resume();
+                }
+
+            private:
+                explicit CoTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+                void reset()
+                {
+                    if (handle_)
+                        handle_.destroy();
+                    handle_ = nullptr;
+                }
+
+                std::coroutine_handle<promise_type> handle_;
+            };
+
+            template <>
+            class CoTask<void>
+            {
+            public:
+                struct promise_type : Detail::PromiseBase
+                {
+                    CoTask get_return_object() { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+                    void return_void() {}
+                };
+
+                CoTask(CoTask &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+                CoTask &operator=(CoTask &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        handle_ = std::exchange(other.handle_, nullptr);
+                    }
+                    return *this;
+                }
+                CoTask(const CoTask &) = delete;
+                CoTask &operator=(const CoTask &) = delete;
+
+                ~CoTask() { reset(); }
+
+                auto operator co_await() && noexcept
+                {
+                    struct Awaiter
+                    {
+                        std::coroutine_handle<promise_type> handle;
+
+                        bool await_ready() noexcept { return !handle || handle.done(); }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept
+                        {
+                            handle.promise().continuation = parent;
+                            return handle;
+                        }
+
+                        void await_resume() noexcept {}
+                    };
+                    return Awaiter{handle_};
+                }
+
+                void detach() &&
+                {
+                    auto handle = std::exchange(handle_, nullptr);
+                    handle.promise().detached = true;
+                    handle.resume();
+                }
+
+            private:
+                explicit CoTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+                void reset()
+                {
+                    if (handle_)
+                        handle_.destroy();
+                    handle_ = nullptr;
+                }
+
+                std::coroutine_handle<promise_type> handle_;
+            };
+        }
+    }
+}
+
+#endif
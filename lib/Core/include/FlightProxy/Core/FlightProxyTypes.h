@@ -1,7 +1,13 @@
 #pragma once
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/Core/Utils/ByteView.h"
+#include "FlightProxy/Core/Utils/PayloadBytes.h"
+#include "FlightProxy/Core/Utils/PoolAllocator.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <array>
 
@@ -9,12 +15,23 @@ namespace FlightProxy
 {
     namespace Core
     {
-        struct MspPacket
+        // Trama ya codificada e inmutable: se codifica una vez y se comparte entre
+        // todos los transportes que la envían (difusión a varios clientes). Puede
+        // apuntar directamente al bloque de recepción del que se decodificó.
+        using SharedFrame = Utils::ByteView;
+
+        // new/delete de paquetes desde un pool si se asigna con MspPacket::setAllocationPool()
+        struct MspPacket : Utils::PooledAllocation<MspPacket>
         {
             char direction;
             uint16_t command;
-            std::vector<uint8_t> payload;
-            MspPacket(char dir, uint8_t cmd, std::vector<uint8_t> pld) : direction(dir), command(cmd), payload(std::move(pld))
+            Utils::PayloadBytes payload; // Propio o vista sobre el bloque de recepción
+
+            // Bytes originales de la trama tal como llegaron (solo si el decoder los
+            // conserva). Permite reenviarla sin volver a codificar.
+            SharedFrame rawFrame;
+
+            MspPacket(char dir, uint16_t cmd, Utils::PayloadBytes pld) : direction(dir), command(cmd), payload(std::move(pld))
             {
                 // FP_LOG_I("MspPacket", "Creado con valores en %p", this);
                 //  esp_backtrace_print(10);
@@ -29,13 +46,44 @@ namespace FlightProxy
                 // FP_LOG_I("MspPacket", "Destruido MspPacket en %p", this);
                 //  esp_backtrace_print(10);
             }
-            MspPacket(const MspPacket &other) : command(other.command), payload(other.payload)
+            MspPacket(const MspPacket &other)
+                : direction(other.direction), command(other.command), payload(other.payload), rawFrame(other.rawFrame)
             {
                 // FP_LOG_I("MspPacket", "Copiado MspPacket a %p desde %p", this, &other);
                 //  esp_backtrace_print(10);
             }
+            MspPacket(MspPacket &&other) = default;
+            MspPacket &operator=(const MspPacket &other) = default;
+            MspPacket &operator=(MspPacket &&other) = default;
         };
 
+        // Trama original de un paquete, si la tiene (nullptr en otro caso)
+        template <typename PacketT>
+        inline const SharedFrame *rawFrameOf(const PacketT &)
+        {
+            return nullptr;
+        }
+
+        inline const SharedFrame *rawFrameOf(const MspPacket &packet)
+        {
+            return packet.rawFrame ? &packet.rawFrame : nullptr;
+        }
+
+        // Copia que no retiene buffers de recepción (para guardarla mucho tiempo)
+        template <typename PacketT>
+        inline PacketT detachedCopy(const PacketT &packet)
+        {
+            return packet;
+        }
+
+        inline MspPacket detachedCopy(const MspPacket &packet)
+        {
+            MspPacket copy(packet);
+            copy.payload.detach();
+            copy.rawFrame = copy.rawFrame.detached();
+            return copy;
+        }
+
         struct IBUSPacket
         {
             static constexpr size_t NUM_CHANNELS = 14;
@@ -43,11 +91,20 @@ namespace FlightProxy
             ChannelsT channels;
         };
 
+        // Contadores de un cliente; viven en su entrada del registro del agregador
+        struct ClientCounters
+        {
+            std::atomic<uint32_t> queued{0}; // Comandos en cola (cuota del CommandManager)
+        };
+
+        // Solo movible: el sobre es dueño del paquete mientras viaja por las colas
         template <typename PacketT>
         struct PacketEnvelope
         {
-            const PacketT *raw_packet_ptr; // El paquete de datos real
-            uint32_t channelId;            // ID del canal para saber a quién responder
+            std::unique_ptr<const PacketT> packet; // El paquete de datos real
+            uint32_t channelId = 0;                // ID del canal para saber a quién responder
+            uint64_t enqueuedAtMs = 0;             // Momento de entrada en la cola (para expirar)
+            std::shared_ptr<ClientCounters> client; // Null si el origen no lleva registro de clientes
         };
 
         // Tipos de datos comunes para el sistema
@@ -0,0 +1,530 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/IMutex.h"
+#include "FlightProxy/Core/OSAL/IQueue.h"
+#include "FlightProxy/Core/Utils/LatencyHistogram.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Contención de locks y colas. Solo mide con -DFP_ENABLE_CONTENTION_STATS; sin
+// la flag los probes están vacíos, TrackedLock<L> es L y las factorías
+// devuelven las primitivas de siempre.
+//
+//   auto mutex = Factory::createMutex("SimpleTCP");           // IMutex instrumentado
+//   auto queue = Factory::createQueue<Msg>(16, "Telemetria"); // IQueue instrumentada
+//   Core::OSAL::TrackedLock<Core::OSAL::Mutex> lock{"Almacen.slot"};
+//
+//   FP_CONTENTION_DUMP(); // Vuelca al log los peores locks y colas
+//
+// Las primitivas con el mismo nombre comparten estadísticas (p. ej. el mutex de
+// cada conexión TCP).
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            struct LockStats
+            {
+                explicit LockStats(std::string lockName) : name(std::move(lockName)) {}
+
+                const std::string name;
+                std::atomic<uint32_t> acquisitions{0};
+                std::atomic<uint32_t> contended{0};   // Adquisiciones que tuvieron que esperar
+                std::atomic<uint32_t> failedTries{0}; // try_lock/tryLock que no lo consiguieron
+                Utils::LatencyHistogram waitUs;       // Espera hasta conseguirlo (0 si estaba libre)
+                Utils::LatencyHistogram holdUs;       // Tiempo dentro (solo exclusivo)
+
+                void reset()
+                {
+                    acquisitions.store(0, std::memory_order_relaxed);
+                    contended.store(0, std::memory_order_relaxed);
+                    failedTries.store(0, std::memory_order_relaxed);
+                    waitUs.reset();
+                    holdUs.reset();
+                }
+            };
+
+            struct QueueStats
+            {
+                explicit QueueStats(std::string queueName) : name(std::move(queueName)) {}
+
+                const std::string name;
+                std::atomic<uint32_t> capacity{0};
+                std::atomic<uint32_t> sends{0};
+                std::atomic<uint32_t> sendTimeouts{0}; // Envíos que no entraron (cola llena)
+                std::atomic<uint32_t> drops{0};        // Ítems descartados por política (p. ej. dropOldest)
+                std::atomic<uint32_t> receives{0};
+                std::atomic<uint32_t> depthHighWater{0};
+                Utils::LatencyHistogram sendWaitUs; // Tiempo dentro de send()
+
+                void reset()
+                {
+                    sends.store(0, std::memory_order_relaxed);
+                    sendTimeouts.store(0, std::memory_order_relaxed);
+                    drops.store(0, std::memory_order_relaxed);
+                    receives.store(0, std::memory_order_relaxed);
+                    depthHighWater.store(0, std::memory_order_relaxed);
+                    sendWaitUs.reset();
+                }
+
+                // La ocupación se cuenta fuera de la cola y puede pasarse en uno
+                // (recepción aún sin anotar): se recorta a la capacidad
+                void noteDepth(int32_t depth)
+                {
+                    if (depth <= 0)
+                        return;
+                    uint32_t value = static_cast<uint32_t>(depth);
+                    uint32_t cap = capacity.load(std::memory_order_relaxed);
+                    if (cap > 0 && value > cap)
+                        value = cap;
+                    uint32_t prev = depthHighWater.load(std::memory_order_relaxed);
+                    while (value > prev && !depthHighWater.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+                    {
+                    }
+                }
+            };
+
+            /**
+             * @brief Estadísticas de contención de todo el sistema, por nombre.
+             *
+             * Las entradas se crean al crear la primitiva y no se borran nunca (son
+             * pocas y con nombre fijo). No usa la factoría del OSAL (la incluyen las
+             * propias factorías): el mutex es std::mutex y solo se toma al dar de alta,
+             * en dump() y en reset().
+             */
+            class ContentionRegistry
+            {
+            public:
+                static ContentionRegistry &instance()
+                {
+                    static ContentionRegistry registry;
+                    return registry;
+                }
+
+                std::shared_ptr<LockStats> lockStats(const char *name)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return findOrAdd(locks_, name);
+                }
+
+                std::shared_ptr<QueueStats> queueStats(const char *name, size_t capacity)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    std::shared_ptr<QueueStats> stats = findOrAdd(queues_, name);
+                    uint32_t value = static_cast<uint32_t>(capacity);
+                    if (value > stats->capacity.load(std::memory_order_relaxed))
+                        stats->capacity.store(value, std::memory_order_relaxed);
+                    return stats;
+                }
+
+                /**
+                 * @brief Vuelca al log los 'top' peores de cada tipo.
+                 * Locks: por tiempo total de espera. Colas: por envíos fallidos y
+                 * descartes, y luego por ocupación máxima.
+                 */
+                void dump(size_t top = 5, bool reset = false)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    std::vector<LockStats *> locks;
+                    for (auto &stats : locks_)
+                    {
+                        if (stats->acquisitions.load(std::memory_order_relaxed) || stats->failedTries.load(std::memory_order_relaxed))
+                            locks.push_back(stats.get());
+                    }
+                    std::sort(locks.begin(), locks.end(), [](const LockStats *a, const LockStats *b)
+                              { return a->waitUs.totalUs() > b->waitUs.totalUs(); });
+                    for (size_t i = 0; i < locks.size() && i < top; ++i)
+                    {
+                        const LockStats &s = *locks[i];
+                        FP_LOG_I("Contention", "lock %-20s n=%u contended=%u failed=%u wait(p99/max)=%u/%uus hold(p99/max)=%u/%uus",
+                                 s.name.c_str(), (unsigned)s.acquisitions.load(std::memory_order_relaxed),
+                                 (unsigned)s.contended.load(std::memory_order_relaxed),
+                                 (unsigned)s.failedTries.load(std::memory_order_relaxed),
+                                 (unsigned)s.waitUs.percentileUs(990), (unsigned)s.waitUs.maxUs(),
+                                 (unsigned)s.holdUs.percentileUs(990), (unsigned)s.holdUs.maxUs());
+                    }
+
+                    std::vector<QueueStats *> queues;
+                    for (auto &stats : queues_)
+                    {
+                        if (stats->sends.load(std::memory_order_relaxed) || stats->sendTimeouts.load(std::memory_order_relaxed))
+                            queues.push_back(stats.get());
+                    }
+                    std::sort(queues.begin(), queues.end(), [](const QueueStats *a, const QueueStats *b)
+                              {
+                        uint32_t lostA = a->sendTimeouts.load(std::memory_order_relaxed) + a->drops.load(std::memory_order_relaxed);
+                        uint32_t lostB = b->sendTimeouts.load(std::memory_order_relaxed) + b->drops.load(std::memory_order_relaxed);
+                        if (lostA != lostB)
+                            return lostA > lostB;
+                        return a->depthHighWater.load(std::memory_order_relaxed) > b->depthHighWater.load(std::memory_order_relaxed); });
+                    for (size_t i = 0; i < queues.size() && i < top; ++i)
+                    {
+                        const QueueStats &s = *queues[i];
+                        FP_LOG_I("Contention", "queue %-19s sent=%u recv=%u timeouts=%u drops=%u depthMax=%u/%u sendWait(p99/max)=%u/%uus",
+                                 s.name.c_str(), (unsigned)s.sends.load(std::memory_order_relaxed),
+                                 (unsigned)s.receives.load(std::memory_order_relaxed),
+                                 (unsigned)s.sendTimeouts.load(std::memory_order_relaxed),
+                                 (unsigned)s.drops.load(std::memory_order_relaxed),
+                                 (unsigned)s.depthHighWater.load(std::memory_order_relaxed),
+                                 (unsigned)s.capacity.load(std::memory_order_relaxed),
+                                 (unsigned)s.sendWaitUs.percentileUs(990), (unsigned)s.sendWaitUs.maxUs());
+                    }
+
+                    if (reset)
+                        resetLocked();
+                }
+
+                void reset()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    resetLocked();
+                }
+
+            private:
+                ContentionRegistry() = default;
+
+                template <typename Stats>
+                static std::shared_ptr<Stats> findOrAdd(std::vector<std::shared_ptr<Stats>> &list, const char *name)
+                {
+                    for (auto &stats : list)
+                    {
+                        if (stats->name == name)
+                            return stats;
+                    }
+                    list.push_back(std::make_shared<Stats>(name));
+                    return list.back();
+                }
+
+                void resetLocked()
+                {
+                    for (auto &stats : locks_)
+                        stats->reset();
+                    for (auto &stats : queues_)
+                        stats->reset();
+                }
+
+                std::mutex mutex_;
+                std::vector<std::shared_ptr<LockStats>> locks_;
+                std::vector<std::shared_ptr<QueueStats>> queues_;
+            };
+
+#if defined(FP_ENABLE_CONTENTION_STATS)
+            // Reloj de las medidas: steady_clock (en ESP-IDF va sobre esp_timer)
+            inline uint32_t contentionNowUs()
+            {
+                return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                                 std::chrono::steady_clock::now().time_since_epoch())
+                                                 .count());
+            }
+
+            /**
+             * @brief Anota las adquisiciones de un lock concreto.
+             * heldSince_ solo lo toca quien tiene el lock en exclusiva.
+             */
+            class LockProbe
+            {
+            public:
+                explicit LockProbe(const char *name) : stats_(ContentionRegistry::instance().lockStats(name)) {}
+
+                void acquired(uint32_t waitUs, bool contended)
+                {
+                    stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+                    if (contended)
+                        stats_->contended.fetch_add(1, std::memory_order_relaxed);
+                    stats_->waitUs.record(waitUs);
+                    heldSince_ = contentionNowUs();
+                }
+
+                void acquiredShared(uint32_t waitUs, bool contended)
+                {
+                    stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+                    if (contended)
+                        stats_->contended.fetch_add(1, std::memory_order_relaxed);
+                    stats_->waitUs.record(waitUs);
+                }
+
+                void releasing() { stats_->holdUs.record(contentionNowUs() - heldSince_); }
+                void failed() { stats_->failedTries.fetch_add(1, std::memory_order_relaxed); }
+
+            private:
+                std::shared_ptr<LockStats> stats_;
+                uint32_t heldSince_ = 0;
+            };
+
+            /**
+             * @brief Anota los envíos y recepciones de una cola concreta.
+             * La ocupación es la de esta cola; la máxima se agrega por nombre.
+             */
+            class QueueProbe
+            {
+            public:
+                QueueProbe(const char *name, size_t capacity)
+                    : stats_(ContentionRegistry::instance().queueStats(name, capacity)) {}
+
+                void sent(size_t count, uint32_t waitUs)
+                {
+                    stats_->sends.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+                    stats_->sendWaitUs.record(waitUs);
+                    stats_->noteDepth(depth_.fetch_add(static_cast<int32_t>(count), std::memory_order_relaxed) +
+                                      static_cast<int32_t>(count));
+                }
+
+                void sendFailed(uint32_t waitUs)
+                {
+                    stats_->sendTimeouts.fetch_add(1, std::memory_order_relaxed);
+                    stats_->sendWaitUs.record(waitUs);
+                }
+
+                void received(size_t count)
+                {
+                    stats_->receives.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+                    depth_.fetch_sub(static_cast<int32_t>(count), std::memory_order_relaxed);
+                }
+
+                // Ítems que ya estaban en la cola y se tiran (no cuentan como recibidos)
+                void dropped(size_t count)
+                {
+                    stats_->drops.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+                    depth_.fetch_sub(static_cast<int32_t>(count), std::memory_order_relaxed);
+                }
+
+            private:
+                std::shared_ptr<QueueStats> stats_;
+                std::atomic<int32_t> depth_{0};
+            };
+
+            /**
+             * @brief Lock por tipo concreto (Core::OSAL::Mutex, SharedMutex) con medidas.
+             * Prueba primero try_lock: si está libre no lee el reloj para la espera.
+             * Los métodos compartidos solo existen si Lock los tiene.
+             */
+            template <typename Lock>
+            class TrackedLock : private Lock
+            {
+            public:
+                explicit TrackedLock(const char *name) : probe_(name) {}
+
+                void lock()
+                {
+                    if (Lock::try_lock())
+                    {
+                        probe_.acquired(0, false);
+                        return;
+                    }
+                    uint32_t start = contentionNowUs();
+                    Lock::lock();
+                    probe_.acquired(contentionNowUs() - start, true);
+                }
+
+                bool try_lock()
+                {
+                    if (!Lock::try_lock())
+                    {
+                        probe_.failed();
+                        return false;
+                    }
+                    probe_.acquired(0, false);
+                    return true;
+                }
+
+                void unlock()
+                {
+                    probe_.releasing();
+                    Lock::unlock();
+                }
+
+                void lock_shared()
+                {
+                    if (Lock::try_lock_shared())
+                    {
+                        probe_.acquiredShared(0, false);
+                        return;
+                    }
+                    uint32_t start = contentionNowUs();
+                    Lock::lock_shared();
+                    probe_.acquiredShared(contentionNowUs() - start, true);
+                }
+
+                bool try_lock_shared()
+                {
+                    if (!Lock::try_lock_shared())
+                    {
+                        probe_.failed();
+                        return false;
+                    }
+                    probe_.acquiredShared(0, false);
+                    return true;
+                }
+
+                void unlock_shared() { Lock::unlock_shared(); }
+
+            private:
+                LockProbe probe_;
+            };
+
+            /**
+             * @brief IMutex (recursivo) con medidas, para Factory::createMutex(name).
+             * Solo cuenta la adquisición más externa; la hace la factoría.
+             */
+            class InstrumentedMutex : public IMutex
+            {
+            public:
+                InstrumentedMutex(std::unique_ptr<IMutex> inner, const char *name)
+                    : inner_(std::move(inner)), probe_(name) {}
+
+                void lock() override
+                {
+                    bool contended = false;
+                    uint32_t start = 0;
+                    if (!inner_->tryLock(0))
+                    {
+                        contended = true;
+                        start = contentionNowUs();
+                        inner_->lock();
+                    }
+                    if (depth_++ == 0)
+                        probe_.acquired(contended ? contentionNowUs() - start : 0, contended);
+                }
+
+                void unlock() override
+                {
+                    if (--depth_ == 0)
+                        probe_.releasing();
+                    inner_->unlock();
+                }
+
+                bool tryLock(uint32_t timeout_ms) override
+                {
+                    bool contended = false;
+                    uint32_t start = 0;
+                    if (!inner_->tryLock(0))
+                    {
+                        if (timeout_ms == 0)
+                        {
+                            probe_.failed();
+                            return false;
+                        }
+                        contended = true;
+                        start = contentionNowUs();
+                        if (!inner_->tryLock(timeout_ms))
+                        {
+                            probe_.failed();
+                            return false;
+                        }
+                    }
+                    if (depth_++ == 0)
+                        probe_.acquired(contended ? contentionNowUs() - start : 0, contended);
+                    return true;
+                }
+
+            private:
+                std::unique_ptr<IMutex> inner_;
+                LockProbe probe_;
+                uint32_t depth_ = 0; // Solo lo toca el dueño del mutex
+            };
+
+            /**
+             * @brief IQueue con medidas, para Factory::createQueue<T>(len, name).
+             */
+            template <typename T>
+            class InstrumentedQueue : public IQueue<T>
+            {
+            public:
+                using IQueue<T>::send;
+
+                InstrumentedQueue(std::unique_ptr<IQueue<T>> inner, size_t capacity, const char *name)
+                    : inner_(std::move(inner)), probe_(name, capacity) {}
+
+                bool send(T &&item, uint32_t timeout_ms) override
+                {
+                    uint32_t start = contentionNowUs();
+                    bool ok = inner_->send(std::move(item), timeout_ms);
+                    uint32_t waitUs = contentionNowUs() - start;
+                    if (ok)
+                        probe_.sent(1, waitUs);
+                    else
+                        probe_.sendFailed(waitUs);
+                    return ok;
+                }
+
+                bool receive(T &item, uint32_t timeout_ms) override
+                {
+                    bool ok = inner_->receive(item, timeout_ms);
+                    if (ok)
+                        probe_.received(1);
+                    return ok;
+                }
+
+                size_t sendN(T *items, size_t count, uint32_t timeout_ms) override
+                {
+                    uint32_t start = contentionNowUs();
+                    size_t sent = inner_->sendN(items, count, timeout_ms);
+                    uint32_t waitUs = contentionNowUs() - start;
+                    if (sent > 0)
+                        probe_.sent(sent, waitUs);
+                    if (sent < count)
+                        probe_.sendFailed(waitUs);
+                    return sent;
+                }
+
+                size_t receiveN(T *items, size_t maxItems, uint32_t timeout_ms) override
+                {
+                    size_t received = inner_->receiveN(items, maxItems, timeout_ms);
+                    if (received > 0)
+                        probe_.received(received);
+                    return received;
+                }
+
+            private:
+                std::unique_ptr<IQueue<T>> inner_;
+                QueueProbe probe_;
+            };
+
+#define FP_CONTENTION_DUMP() FlightProxy::Core::OSAL::ContentionRegistry::instance().dump(5, true)
+#else
+            class LockProbe
+            {
+            public:
+                explicit LockProbe(const char *) {}
+                void acquired(uint32_t, bool) {}
+                void acquiredShared(uint32_t, bool) {}
+                void releasing() {}
+                void failed() {}
+            };
+
+            class QueueProbe
+            {
+            public:
+                QueueProbe(const char *, size_t) {}
+                void sent(size_t, uint32_t) {}
+                void sendFailed(uint32_t) {}
+                void received(size_t) {}
+                void dropped(size_t) {}
+            };
+
+            // Sin la flag es el propio lock: el nombre se ignora
+            template <typename Lock>
+            class TrackedLock : public Lock
+            {
+            public:
+                explicit TrackedLock(const char *) {}
+            };
+
+#define FP_CONTENTION_DUMP() ((void)0)
+#endif
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            struct BlockPoolStats
+            {
+                size_t blockSize = 0;      // Bytes por bloque (ya alineado)
+                size_t blockCount = 0;     // Bloques totales
+                size_t inUse = 0;          // Bloques entregados ahora mismo
+                size_t highWatermark = 0;  // Máximo de bloques en uso a la vez
+                uint32_t exhausted = 0;    // Peticiones sin bloque libre (se devolvió nullptr)
+            };
+
+            /**
+             * @brief Pool de bloques de tamaño fijo reservado una sola vez al crearlo.
+             * allocate() y deallocate() son O(1) y no tocan el heap general.
+             */
+            class IBlockPool
+            {
+            public:
+                virtual ~IBlockPool() = default;
+
+                // nullptr si no queda ningún bloque libre
+                virtual void *allocate() = 0;
+                virtual void deallocate(void *block) = 0;
+
+                // true si el puntero es un bloque de este pool
+                virtual bool owns(const void *ptr) const = 0;
+
+                virtual size_t blockSize() const = 0;
+                virtual BlockPoolStats getStats() const = 0;
+            };
+        }
+    }
+}
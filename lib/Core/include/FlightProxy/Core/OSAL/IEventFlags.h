@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Grupo de flags de eventos para despertar tareas sin mover datos.
+             *
+             * set() nunca bloquea y no reserva memoria; las flags quedan activas hasta
+             * que alguien las consume (clearOnExit) o las limpia, así que un aviso que
+             * llega antes de que la tarea espere no se pierde. Varias tareas pueden
+             * esperar en el mismo grupo.
+             *
+             * Solo se garantizan los bits 0..23 (límite de los event groups de FreeRTOS).
+             */
+            class IEventFlags
+            {
+            public:
+                using Bits = uint32_t;
+
+                virtual ~IEventFlags() = default;
+
+                virtual void set(Bits bits) = 0;
+                virtual void clear(Bits bits) = 0;
+                virtual Bits get() const = 0;
+
+                /**
+                 * @brief Espera a que se activen las flags pedidas.
+                 * @param bits Flags que interesan.
+                 * @param waitAll true = todas a la vez; false = cualquiera.
+                 * @param clearOnExit Si se cumple, limpia 'bits' al salir.
+                 * @param timeout_ms Tiempo de espera en milisegundos.
+                 * @return Las flags activas al salir (antes de limpiarlas). Si hubo
+                 *         timeout no cumplen la condición.
+                 */
+                virtual Bits wait(Bits bits, bool waitAll, bool clearOnExit, uint32_t timeout_ms) = 0;
+
+                // Espera a cualquiera y consume las que se activaron. Devuelve 0 si hubo timeout.
+                Bits waitAny(Bits bits, uint32_t timeout_ms)
+                {
+                    return wait(bits, false, true, timeout_ms) & bits;
+                }
+
+                // Espera a todas y las consume. false si hubo timeout.
+                bool waitAll(Bits bits, uint32_t timeout_ms)
+                {
+                    return (wait(bits, true, true, timeout_ms) & bits) == bits;
+                }
+            };
+
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Ejecuta trabajos cortos en un conjunto fijo de tareas.
+             *
+             * Para componentes que no necesitan una tarea propia (callbacks, handlers
+             * de comandos, transacts...): encolan el trabajo y vuelven. Los trabajos no
+             * deben bloquear mucho tiempo; el orden entre trabajos de distintas tareas
+             * no está garantizado.
+             */
+            class IExecutor
+            {
+            public:
+                using Job = std::function<void()>;
+
+                virtual ~IExecutor() = default;
+
+                /**
+                 * @brief Encola un trabajo.
+                 * @return false si el executor está parado (el trabajo no se ejecutará).
+                 */
+                virtual bool post(Job job) = 0;
+
+                virtual size_t workerCount() const = 0;
+            };
+
+        }
+    }
+}
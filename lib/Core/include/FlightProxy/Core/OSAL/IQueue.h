@@ -1,5 +1,7 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace FlightProxy
 {
@@ -8,6 +10,13 @@ namespace FlightProxy
         namespace OSAL
         {
 
+            /**
+             * @brief Cola entre tareas.
+             *
+             * Los ítems se mueven (no se copian), así que T puede ser un tipo solo
+             * movible como std::unique_ptr: la propiedad viaja con el ítem y, si el
+             * envío falla, el ítem sigue siendo del llamador.
+             */
             template <typename T>
             class IQueue
             {
@@ -15,22 +24,64 @@ namespace FlightProxy
                 virtual ~IQueue() = default;
 
                 /**
-                 * @brief Envía un ítem a la cola.
-                 * @param item El ítem a copiar en la cola.
+                 * @brief Envía un ítem a la cola (se mueve dentro de la cola).
+                 * @param item El ítem a enviar. Si hay timeout no se toca.
                  * @param timeout_ms Tiempo de espera en milisegundos.
                  * @return true si se envió correctamente, false si hubo timeout.
                  */
-                virtual bool send(const T &item, uint32_t timeout_ms) = 0;
+                virtual bool send(T &&item, uint32_t timeout_ms) = 0;
+
+                /**
+                 * @brief Envía una copia del ítem (solo para tipos copiables).
+                 */
+                bool send(const T &item, uint32_t timeout_ms)
+                {
+                    T copy(item);
+                    return send(std::move(copy), timeout_ms);
+                }
 
                 /**
                  * @brief Recibe un ítem de la cola.
-                 * @param item Referencia donde se copiará el ítem recibido.
+                 * @param item Referencia donde se moverá el ítem recibido.
                  * @param timeout_ms Tiempo de espera en milisegundos.
                  * @return true si se recibió un ítem, false si hubo timeout.
                  */
                 virtual bool receive(T &item, uint32_t timeout_ms) = 0;
+
+                /**
+                 * @brief Envía hasta 'count' ítems de una vez.
+                 * Espera hasta timeout_ms a que quepa el primero; el resto solo entra si
+                 * hay hueco en ese momento.
+                 * @return Número de ítems enviados (los primeros de 'items'). Los que no
+                 *         entran se quedan intactos.
+                 */
+                virtual size_t sendN(T *items, size_t count, uint32_t timeout_ms)
+                {
+                    size_t sent = 0;
+                    while (sent < count && send(std::move(items[sent]), sent == 0 ? timeout_ms : 0))
+                    {
+                        sent++;
+                    }
+                    return sent;
+                }
+
+                /**
+                 * @brief Recibe hasta 'maxItems' ítems con un solo despertar.
+                 * Espera hasta timeout_ms al primero y recoge sin esperar los que ya
+                 * estén en la cola.
+                 * @return Número de ítems recibidos (0 si hubo timeout).
+                 */
+                virtual size_t receiveN(T *items, size_t maxItems, uint32_t timeout_ms)
+                {
+                    size_t received = 0;
+                    while (received < maxItems && receive(items[received], received == 0 ? timeout_ms : 0))
+                    {
+                        received++;
+                    }
+                    return received;
+                }
             };
 
         } // namespace OSAL
     } // namespace Core
-} // namespace FlightProxy
\ No newline at end of file
+} // namespace FlightProxy
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            // Locks ligeros por tipo concreto: sin llamada virtual ni unique_ptr.
+            // Se usan con std::lock_guard / std::shared_lock como los de la STL.
+            //
+            // - Mutex: no recursivo. Para secciones cortas que no se vuelven a
+            //   tomar desde dentro (IMutex sigue siendo el recursivo).
+            // - SpinLock: para unas pocas copias de datos. En ESP32 desactiva las
+            //   interrupciones del núcleo: nada de bloquear, loguear ni llamar a la API
+            //   del RTOS mientras se tiene.
+            // - SharedMutex: lectores en paralelo y un escritor (prioritario), para
+            //   tablas que casi solo se leen.
+            //
+            // Para medir su contención: TrackedLock<Mutex> / TrackedLock<SharedMutex>
+            // con nombre (ver ContentionStats.h). El SpinLock no se mide: en ESP32 no
+            // tiene try_lock y leer el reloj dentro de la sección crítica no compensa.
+            using Mutex = Factory::Mutex;
+            using SpinLock = Factory::SpinLock;
+            using SharedMutex = Factory::SharedMutex;
+        }
+    }
+}
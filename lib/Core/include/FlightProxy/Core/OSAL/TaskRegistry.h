@@ -0,0 +1,259 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/ITask.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            // Contadores crudos que da la plataforma para una tarea
+            struct TaskCounters
+            {
+                uint64_t runTime = 0;         // CPU consumida por la tarea...
+                uint64_t timeBase = 0;        // ...y reloj de referencia, en las mismas unidades
+                uint64_t contextSwitches = 0; // Cambios de contexto acumulados
+                uint32_t stackFreeBytes = 0;  // Mínimo de pila libre desde que arrancó
+                bool hasRunTime = false;
+                bool hasContextSwitches = false;
+                bool hasStack = false;
+            };
+
+            /**
+             * @brief Lee los contadores de una tarea desde otra tarea.
+             * Cada plataforma la crea en la propia tarea (captura su handle/id).
+             */
+            class ITaskProbe
+            {
+            public:
+                virtual ~ITaskProbe() = default;
+                virtual bool read(TaskCounters &counters) = 0;
+            };
+
+            struct TaskStats
+            {
+                std::string name;
+                uint32_t stackSize = 0;
+                int priority = 0;
+                int coreId = -1;
+                float cpuPercent = -1.0f;     // % de un núcleo en la última ventana; -1 si no se sabe
+                uint64_t contextSwitches = 0; // Acumulados (si la plataforma no los da: despertares del OSAL)
+                int64_t stackFreeBytes = -1;  // Mínimo de pila libre; -1 si no se sabe
+                uint32_t wakeups = 0;         // Despertares por flags de eventos en la última ventana
+                uint32_t wakeLatencyAvgUs = 0; // Desde set() hasta que la tarea corre, en la última ventana
+                uint32_t wakeLatencyMaxUs = 0;
+            };
+
+            /**
+             * @brief Registro de todas las tareas del sistema y de sus estadísticas.
+             *
+             * Cada tarea se registra desde su propio hilo con una Registration (las de la
+             * factoría lo hacen solas; las de los transportes lo hacen al arrancar) y se
+             * borra al terminar. sample() cierra una ventana de medida: CPU, cambios de
+             * contexto y pila vienen de la plataforma (ITaskProbe); la latencia de
+             * despertar la anotan las flags de eventos con noteWake() sin bloquear.
+             *
+             * No usa la factoría del OSAL (la incluyen las propias tareas): el mutex es
+             * std::mutex, que en ESP-IDF va sobre FreeRTOS.
+             */
+            class TaskRegistry
+            {
+                struct Record;
+
+            public:
+                static TaskRegistry &instance()
+                {
+                    static TaskRegistry registry;
+                    return registry;
+                }
+
+                /**
+                 * @brief Alta de la tarea actual mientras viva el objeto.
+                 * Se crea dentro de la tarea; end() da de baja antes de tiempo (p. ej.
+                 * antes de vTaskDelete(NULL), que no ejecuta destructores).
+                 */
+                class Registration
+                {
+                public:
+                    Registration(const TaskConfig &config, std::unique_ptr<ITaskProbe> probe)
+                        : record_(std::make_shared<Record>())
+                    {
+                        record_->config = config;
+                        record_->probe = std::move(probe);
+                        current() = record_.get();
+                        TaskRegistry::instance().add(record_);
+                    }
+
+                    ~Registration() { end(); }
+
+                    Registration(const Registration &) = delete;
+                    Registration &operator=(const Registration &) = delete;
+
+                    void end()
+                    {
+                        if (!record_)
+                            return;
+                        // Puede llamarse desde otra tarea (p. ej. tras un vTaskDelete externo)
+                        if (current() == record_.get())
+                            current() = nullptr;
+                        TaskRegistry::instance().remove(record_.get());
+                        record_.reset();
+                    }
+
+                private:
+                    std::shared_ptr<Record> record_;
+                };
+
+                /**
+                 * @brief Anota un despertar de la tarea actual y su latencia.
+                 * No bloquea; si la tarea no está registrada no hace nada.
+                 */
+                static void noteWake(uint32_t latencyUs)
+                {
+                    Record *record = current();
+                    if (!record)
+                        return;
+                    record->wakeups.fetch_add(1, std::memory_order_relaxed);
+                    record->totalWakeups.fetch_add(1, std::memory_order_relaxed);
+                    record->latencyTotalUs.fetch_add(latencyUs, std::memory_order_relaxed);
+                    uint32_t prev = record->latencyMaxUs.load(std::memory_order_relaxed);
+                    while (latencyUs > prev &&
+                           !record->latencyMaxUs.compare_exchange_weak(prev, latencyUs, std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                // Cierra la ventana actual y recalcula las estadísticas de todas las tareas
+                void sample()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (auto &record : records_)
+                    {
+                        sampleRecord(*record);
+                    }
+                }
+
+                // Estadísticas de la última ventana cerrada con sample()
+                std::vector<TaskStats> snapshot() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    std::vector<TaskStats> result;
+                    result.reserve(records_.size());
+                    for (const auto &record : records_)
+                    {
+                        result.push_back(record->stats);
+                    }
+                    return result;
+                }
+
+                size_t taskCount() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return records_.size();
+                }
+
+                void dump() const
+                {
+                    for (const TaskStats &s : snapshot())
+                    {
+                        FP_LOG_I("TaskRegistry", "%-16s prio=%d cpu=%5.1f%% ctx=%llu stackFree=%lld/%u wake=%u lat(avg/max)=%u/%uus",
+                                 s.name.c_str(), s.priority, s.cpuPercent,
+                                 (unsigned long long)s.contextSwitches, (long long)s.stackFreeBytes,
+                                 (unsigned)s.stackSize, (unsigned)s.wakeups,
+                                 (unsigned)s.wakeLatencyAvgUs, (unsigned)s.wakeLatencyMaxUs);
+                    }
+                }
+
+            private:
+                struct Record
+                {
+                    TaskConfig config;
+                    std::unique_ptr<ITaskProbe> probe;
+
+                    // Ventana en curso (la escribe la propia tarea sin lock)
+                    std::atomic<uint32_t> wakeups{0};
+                    std::atomic<uint32_t> latencyTotalUs{0};
+                    std::atomic<uint32_t> latencyMaxUs{0};
+                    std::atomic<uint32_t> totalWakeups{0};
+
+                    // Protegido por mutex_
+                    TaskCounters previous;
+                    bool hasPrevious = false;
+                    TaskStats stats;
+                };
+
+                TaskRegistry() = default;
+
+                static Record *&current()
+                {
+                    static thread_local Record *record = nullptr;
+                    return record;
+                }
+
+                void add(const std::shared_ptr<Record> &record)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    record->stats.name = record->config.name;
+                    record->stats.stackSize = record->config.stackSize;
+                    record->stats.priority = record->config.priority;
+                    record->stats.coreId = record->config.coreId;
+                    records_.push_back(record);
+                }
+
+                void remove(Record *record)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    records_.erase(std::remove_if(records_.begin(), records_.end(),
+                                                  [record](const std::shared_ptr<Record> &r)
+                                                  { return r.get() == record; }),
+                                   records_.end());
+                }
+
+                static void sampleRecord(Record &record)
+                {
+                    TaskStats &stats = record.stats;
+
+                    uint32_t wakeups = record.wakeups.exchange(0, std::memory_order_relaxed);
+                    uint32_t latencyTotal = record.latencyTotalUs.exchange(0, std::memory_order_relaxed);
+                    stats.wakeups = wakeups;
+                    stats.wakeLatencyAvgUs = wakeups ? latencyTotal / wakeups : 0;
+                    stats.wakeLatencyMaxUs = record.latencyMaxUs.exchange(0, std::memory_order_relaxed);
+
+                    TaskCounters now;
+                    bool ok = record.probe && record.probe->read(now);
+
+                    stats.contextSwitches = (ok && now.hasContextSwitches)
+                                                ? now.contextSwitches
+                                                : record.totalWakeups.load(std::memory_order_relaxed);
+                    stats.stackFreeBytes = (ok && now.hasStack) ? int64_t(now.stackFreeBytes) : -1;
+
+                    stats.cpuPercent = -1.0f;
+                    if (ok && now.hasRunTime && record.hasPrevious && now.timeBase > record.previous.timeBase)
+                    {
+                        uint64_t run = now.runTime - record.previous.runTime;
+                        uint64_t base = now.timeBase - record.previous.timeBase;
+                        stats.cpuPercent = 100.0f * float(run) / float(base);
+                    }
+                    if (ok)
+                    {
+                        record.previous = now;
+                        record.hasPrevious = true;
+                    }
+                }
+
+                mutable std::mutex mutex_;
+                std::vector<std::shared_ptr<Record>> records_;
+            };
+        }
+    }
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/Core/Utils/TimerWheel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            struct TimerServiceConfig
+            {
+                uint32_t tickUs = 1000; // Resolución de la rueda
+                size_t initialTimers = 64; // Huecos del primer bloque; si se llenan la rueda crece
+                TaskConfig task{"Timers", 4096, 4, -1};
+            };
+
+            /**
+             * @brief Servicio de temporizadores: una tarea atiende todos los timeouts.
+             *
+             * Temporizadores de un disparo y periódicos sobre una TimerWheel. Los
+             * callbacks se ejecutan en la tarea del servicio (prioridad, pila y núcleo
+             * configurables), de uno en uno y fuera del mutex, así que pueden programar o
+             * cancelar otros temporizadores. Deben ser cortos: un callback lento retrasa
+             * a los demás.
+             *
+             * La tarea duerme en un "timbre" hasta el siguiente vencimiento; programar
+             * uno más cercano la despierta.
+             */
+            class TimerService
+            {
+            public:
+                using TimerId = Utils::TimerWheel::TimerId;
+                using Callback = Utils::TimerWheel::Callback;
+                static constexpr TimerId kInvalidTimer = Utils::TimerWheel::kInvalidTimer;
+
+                explicit TimerService(const TimerServiceConfig &config = TimerServiceConfig())
+                    : config_(config),
+                      wheel_(config.tickUs, config.initialTimers, Factory::getMonotonicTimeUs()),
+                      m_mutex(Factory::createMutex("TimerService")),
+                      doorbell_(Factory::createEventFlags())
+                {
+                }
+
+                ~TimerService()
+                {
+                    stop();
+                }
+
+                TimerService(const TimerService &) = delete;
+                TimerService &operator=(const TimerService &) = delete;
+
+                void start()
+                {
+                    if (isRunning_)
+                        return;
+                    isRunning_ = true;
+                    task_ = Factory::createTask([this]()
+                                                { this->dispatchLoop(); },
+                                                config_.task);
+                    if (task_)
+                        task_->start();
+                }
+
+                void stop()
+                {
+                    if (!isRunning_)
+                        return;
+                    // La tarea sale sola al despertar (sin vTaskDelete a mitad de un callback)
+                    isRunning_ = false;
+                    ring();
+                    if (task_)
+                        task_->join();
+                }
+
+                // Un solo disparo dentro de delayUs
+                TimerId scheduleOnce(uint64_t delayUs, Callback callback)
+                {
+                    return scheduleAt(Factory::getMonotonicTimeUs() + delayUs, 0, std::move(callback));
+                }
+
+                // Cada periodUs; el primero dentro de firstDelayUs (por defecto un periodo)
+                TimerId schedulePeriodic(uint64_t periodUs, Callback callback, uint64_t firstDelayUs = UINT64_MAX)
+                {
+                    if (firstDelayUs == UINT64_MAX)
+                        firstDelayUs = periodUs;
+                    return scheduleAt(Factory::getMonotonicTimeUs() + firstDelayUs, periodUs, std::move(callback));
+                }
+
+                /**
+                 * @brief Programa un temporizador en un instante absoluto (getMonotonicTimeUs).
+                 * @return kInvalidTimer solo si la rueda ya tiene TimerWheel::kMaxTimers.
+                 */
+                TimerId scheduleAt(uint64_t deadlineUs, uint64_t periodUs, Callback callback)
+                {
+                    TimerId id;
+                    bool wake;
+                    size_t before;
+                    size_t after;
+                    {
+                        std::lock_guard<IMutex> lock(*m_mutex);
+                        before = wheel_.capacity();
+                        id = wheel_.schedule(deadlineUs, periodUs, std::move(callback));
+                        after = wheel_.capacity();
+                        wake = (id != kInvalidTimer) && wheel_.nextWakeUs() < plannedWakeUs_;
+                    }
+                    if (id == kInvalidTimer)
+                        FP_LOG_W("TimerService", "Sin huecos para temporizadores (%u)", (unsigned)after);
+                    else if (after != before)
+                        FP_LOG_W("TimerService", "Rueda ampliada a %u temporizadores (subir initialTimers)", (unsigned)after);
+                    if (wake)
+                        ring();
+                    return id;
+                }
+
+                // false si ya había vencido (un disparo) o estaba cancelado
+                bool cancel(TimerId id)
+                {
+                    std::lock_guard<IMutex> lock(*m_mutex);
+                    return wheel_.cancel(id);
+                }
+
+                size_t activeCount()
+                {
+                    std::lock_guard<IMutex> lock(*m_mutex);
+                    return wheel_.activeCount();
+                }
+
+            private:
+                // Espera máxima sin temporizadores, para revisar isRunning_
+                static constexpr uint32_t kIdleWaitMs = 1000;
+
+                TimerServiceConfig config_;
+                Utils::TimerWheel wheel_;
+                std::unique_ptr<IMutex> m_mutex;
+                static constexpr IEventFlags::Bits kWake = 1u << 0;
+                std::unique_ptr<IEventFlags> doorbell_;
+                std::unique_ptr<ITask> task_;
+                std::atomic<bool> isRunning_{false};
+                uint64_t plannedWakeUs_ = 0; // Protegido por m_mutex
+
+                void ring()
+                {
+                    doorbell_->set(kWake);
+                }
+
+                void dispatchLoop()
+                {
+                    while (isRunning_)
+                    {
+                        uint32_t waitMs;
+                        {
+                            std::unique_lock<IMutex> lock(*m_mutex);
+                            wheel_.advance(Factory::getMonotonicTimeUs());
+
+                            Callback *callback;
+                            TimerId id;
+                            while ((id = wheel_.popExpired(callback)) != kInvalidTimer)
+                            {
+                                // El nodo no se reutiliza mientras está en ejecución
+                                lock.unlock();
+                                (*callback)();
+                                lock.lock();
+                                wheel_.finish(id, Factory::getMonotonicTimeUs());
+                            }
+
+                            uint64_t now = Factory::getMonotonicTimeUs();
+                            plannedWakeUs_ = wheel_.nextWakeUs();
+                            if (plannedWakeUs_ <= now)
+                            {
+                                continue; // Ya toca (vencido o cascada durante los callbacks)
+                            }
+                            uint64_t waitUs = plannedWakeUs_ - now;
+                            waitMs = (waitUs >= uint64_t(kIdleWaitMs) * 1000)
+                                         ? kIdleWaitMs
+                                         : static_cast<uint32_t>((waitUs + 999) / 1000);
+                        }
+                        doorbell_->waitAny(kWake, waitMs);
+                    }
+                }
+            };
+        }
+    }
+}
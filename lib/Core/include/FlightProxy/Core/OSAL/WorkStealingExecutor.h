@@ -0,0 +1,282 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/IExecutor.h"
+#include "FlightProxy/Core/OSAL/Locks.h"
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace OSAL
+        {
+            struct ExecutorConfig
+            {
+                size_t workerCount = 0;  // 0 = uno por núcleo (Factory::getCoreCount())
+                bool pinToCores = false; // El worker i se fija al núcleo i (módulo núcleos)
+                TaskConfig task{"Exec", 4096, 3, -1}; // El nombre lleva detrás el índice
+            };
+
+            /**
+             * @brief Executor con una cola por worker y robo de trabajo.
+             *
+             * Un trabajo publicado desde un worker va a su propia cola y el worker la
+             * vacía por el final (LIFO: la continuación corre en caliente en el mismo
+             * núcleo). Los publicados desde fuera se reparten en round-robin. Un worker
+             * sin trabajo roba del principio de la cola de los demás y, si no hay nada,
+             * duerme en sus flags de eventos hasta que alguien publica.
+             *
+             * Las colas son std::deque con un Mutex ligero cada una: el trabajo es
+             * corto y la sección crítica solo mueve un std::function.
+             *
+             * stop() deja de aceptar trabajos y espera a que se ejecuten los ya
+             * aceptados. No se puede llamar desde un trabajo del propio executor.
+             */
+            class WorkStealingExecutor : public IExecutor
+            {
+            public:
+                static constexpr size_t kMaxWorkers = 32; // Un bit por worker en idleMask_
+
+                explicit WorkStealingExecutor(const ExecutorConfig &config = ExecutorConfig())
+                    : config_(config)
+                {
+                    size_t count = config_.workerCount ? config_.workerCount : Factory::getCoreCount();
+                    if (count > kMaxWorkers)
+                        count = kMaxWorkers;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        workers_.push_back(std::make_unique<Worker>());
+                        workers_.back()->wake = Factory::createEventFlags();
+                    }
+                }
+
+                ~WorkStealingExecutor() override
+                {
+                    stop();
+                }
+
+                WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+                WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+                void start()
+                {
+                    if (isRunning_)
+                        return;
+                    isRunning_ = true;
+                    accepting_ = true;
+
+                    size_t cores = Factory::getCoreCount();
+                    for (size_t i = 0; i < workers_.size(); ++i)
+                    {
+                        TaskConfig taskConfig = config_.task;
+                        taskConfig.name = config_.task.name + std::to_string(i);
+                        if (config_.pinToCores)
+                            taskConfig.coreId = static_cast<int>(i % cores);
+
+                        workers_[i]->task = Factory::createTask([this, i]()
+                                                                { this->workerLoop(i); },
+                                                                taskConfig);
+                        if (workers_[i]->task)
+                            workers_[i]->task->start();
+                    }
+                    FP_LOG_I("Executor", "Iniciados %u workers", static_cast<unsigned>(workers_.size()));
+                }
+
+                void stop()
+                {
+                    if (!isRunning_)
+                        return;
+
+                    accepting_ = false;
+                    // Un post() que ya pasó el control de accepting_ termina de encolar
+                    while (posting_.load() != 0)
+                        Factory::sleep(1);
+
+                    // Los workers salen cuando ya no encuentran trabajo
+                    isRunning_ = false;
+                    for (auto &worker : workers_)
+                        worker->wake->set(kWake);
+                    for (auto &worker : workers_)
+                    {
+                        if (worker->task)
+                            worker->task->join();
+                    }
+                }
+
+                bool post(Job job) override
+                {
+                    if (!job)
+                        return false;
+
+                    posting_.fetch_add(1);
+                    if (!accepting_.load())
+                    {
+                        posting_.fetch_sub(1);
+                        return false;
+                    }
+
+                    size_t self = currentWorker();
+                    size_t target = self != kNoWorker ? self : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+                    {
+                        std::lock_guard<Mutex> lock(workers_[target]->mutex);
+                        workers_[target]->jobs.push_back(std::move(job));
+                    }
+                    pending_.fetch_add(1);
+                    posting_.fetch_sub(1);
+
+                    wakeIdle(target);
+                    return true;
+                }
+
+                size_t workerCount() const override { return workers_.size(); }
+
+                // Trabajos ejecutados y cuántos de ellos se robaron a otro worker
+                uint32_t executedCount() const { return executed_.load(std::memory_order_relaxed); }
+                uint32_t stolenCount() const { return stolen_.load(std::memory_order_relaxed); }
+
+            private:
+                static constexpr IEventFlags::Bits kWake = 1u << 0;
+                static constexpr size_t kNoWorker = SIZE_MAX;
+                // Espera máxima dormido, como red de seguridad
+                static constexpr uint32_t kIdleWaitMs = 1000;
+
+                struct Worker
+                {
+                    Mutex mutex;
+                    std::deque<Job> jobs;
+                    std::unique_ptr<IEventFlags> wake;
+                    std::unique_ptr<ITask> task;
+                };
+
+                struct CurrentWorker
+                {
+                    const WorkStealingExecutor *executor = nullptr;
+                    size_t index = 0;
+                };
+
+                static CurrentWorker &current()
+                {
+                    static thread_local CurrentWorker worker;
+                    return worker;
+                }
+
+                size_t currentWorker() const
+                {
+                    const CurrentWorker &cw = current();
+                    return cw.executor == this ? cw.index : kNoWorker;
+                }
+
+                bool popLocal(size_t index, Job &job)
+                {
+                    Worker &worker = *workers_[index];
+                    std::lock_guard<Mutex> lock(worker.mutex);
+                    if (worker.jobs.empty())
+                        return false;
+                    job = std::move(worker.jobs.back());
+                    worker.jobs.pop_back();
+                    return true;
+                }
+
+                bool steal(size_t index, Job &job)
+                {
+                    for (size_t k = 1; k < workers_.size(); ++k)
+                    {
+                        Worker &victim = *workers_[(index + k) % workers_.size()];
+                        std::lock_guard<Mutex> lock(victim.mutex);
+                        if (!victim.jobs.empty())
+                        {
+                            job = std::move(victim.jobs.front());
+                            victim.jobs.pop_front();
+                            stolen_.fetch_add(1, std::memory_order_relaxed);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                /**
+                 * @brief Despierta a un worker dormido (preferiblemente 'preferred').
+                 * El bit se quita aquí para no despertar dos veces al mismo. Junto con
+                 * el orden pending_ / idleMask_ (seq_cst en los dos lados) ningún
+                 * trabajo se queda sin nadie que lo vea.
+                 */
+                void wakeIdle(size_t preferred)
+                {
+                    uint32_t idle = idleMask_.load();
+                    while (idle != 0)
+                    {
+                        uint32_t preferredBit = 1u << preferred;
+                        uint32_t bit = (idle & preferredBit) ? preferredBit : (idle & (~idle + 1)); // El más bajo
+                        if (idleMask_.fetch_and(~bit) & bit)
+                        {
+                            workers_[indexOf(bit)]->wake->set(kWake);
+                            return;
+                        }
+                        idle = idleMask_.load();
+                    }
+                }
+
+                static size_t indexOf(uint32_t bit)
+                {
+                    size_t index = 0;
+                    while (bit >>= 1)
+                        ++index;
+                    return index;
+                }
+
+                void workerLoop(size_t index)
+                {
+                    current().executor = this;
+                    current().index = index;
+                    const uint32_t bit = 1u << index;
+
+                    Job job;
+                    while (true)
+                    {
+                        if (popLocal(index, job) || steal(index, job))
+                        {
+                            pending_.fetch_sub(1);
+                            job();
+                            job = nullptr; // Suelta lo capturado antes de dormir
+                            executed_.fetch_add(1, std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        if (!isRunning_.load())
+                            break;
+
+                        // Nos anunciamos dormidos y volvemos a mirar: un post() que llegue
+                        // entre medias o ve nuestro bit o nosotros vemos su pending_
+                        idleMask_.fetch_or(bit);
+                        if (pending_.load() <= 0 && isRunning_.load())
+                            workers_[index]->wake->waitAny(kWake, kIdleWaitMs);
+                        idleMask_.fetch_and(~bit);
+                    }
+
+                    current().executor = nullptr;
+                }
+
+                ExecutorConfig config_;
+                std::vector<std::unique_ptr<Worker>> workers_;
+                std::atomic<bool> isRunning_{false};
+                std::atomic<bool> accepting_{false};
+                std::atomic<uint32_t> posting_{0};
+                std::atomic<int32_t> pending_{0}; // Encolados y aún sin recoger (puede bajar de 0 un instante)
+                std::atomic<uint32_t> idleMask_{0};
+                std::atomic<size_t> next_{0};
+                std::atomic<uint32_t> executed_{0};
+                std::atomic<uint32_t> stolen_{0};
+            };
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "FlightProxy/Core/Utils/ByteView.h"
 #include <cstdint>
 #include <cstddef>
 #include <memory>
@@ -16,6 +17,14 @@ namespace FlightProxy
             public:
                 virtual ~IDecoderT() = default;
                 virtual void feed(const uint8_t *data, size_t len) = 0;
+
+                // Bytes recibidos en un bloque con propiedad compartida: el decoder puede
+                // emitir paquetes que apunten al bloque en lugar de copiarlo.
+                virtual void feedChunk(const Utils::ByteView &chunk)
+                {
+                    feed(chunk.data(), chunk.size());
+                }
+
                 virtual void onPacket(std::function<void(std::unique_ptr<const PacketT>)> handler) = 0;
                 virtual void reset() = 0;
             };
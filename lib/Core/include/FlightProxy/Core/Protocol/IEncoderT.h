@@ -1,4 +1,5 @@
 #pragma once
+#include "FlightProxy/Core/Transport/IoSlice.h"
 #include <cstdint>
 #include <vector>
 #include <memory>
@@ -9,12 +10,36 @@ namespace FlightProxy
     {
         namespace Protocol
         {
+            // Tamaños para encodeGather(): buffer de cabecera/cola y máximo de trozos
+            constexpr size_t kGatherScratchBytes = 16;
+            constexpr size_t kMaxGatherSlices = 4;
+
             template <typename PacketT>
             class IEncoderT
             {
             public:
                 virtual ~IEncoderT() = default;
                 virtual std::vector<uint8_t> encode(std::unique_ptr<const PacketT> packet) = 0;
+
+                // Codifica sin tomar la propiedad del paquete (p. ej. para difundirlo).
+                // Por defecto hace una copia; los encoders concretos pueden evitarla.
+                virtual std::vector<uint8_t> encodeFrom(const PacketT &packet)
+                {
+                    return encode(std::unique_ptr<const PacketT>(new PacketT(packet)));
+                }
+
+                /**
+                 * @brief Codifica la trama en trozos para ITransport::sendv(): la cabecera y
+                 * la cola se escriben en 'scratch' (kGatherScratchBytes) y el cuerpo apunta al
+                 * almacenamiento del propio paquete, sin copiarlo. Los trozos solo son válidos
+                 * mientras vivan 'packet' y 'scratch'.
+                 * @return Número de trozos en 'slices' (hasta kMaxGatherSlices); 0 si el
+                 * encoder no lo soporta (usar encode()).
+                 */
+                virtual size_t encodeGather(const PacketT &, uint8_t *, Transport::IoSlice *)
+                {
+                    return 0;
+                }
             };
         }
     }
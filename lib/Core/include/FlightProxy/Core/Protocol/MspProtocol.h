@@ -4,6 +4,7 @@
 #include "FlightProxy/Core/Protocol/IEncoderT.h"
 #include "FlightProxy/Core/FlightProxyTypes.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -56,36 +57,77 @@ namespace FlightProxy
             public:
                 std::vector<uint8_t> encode(std::unique_ptr<const FlightProxy::Core::MspPacket> packet) override
                 {
-                    std::vector<uint8_t> buffer;
-                    buffer.push_back('$');
-                    buffer.push_back('X');
-                    buffer.push_back(packet->direction); // '<' o '>'
-                    buffer.push_back(0);                 // Flag (siempre 0)
+                    return encodeFrom(*packet);
+                }
 
-                    uint16_t cmd = packet->command;
-                    uint16_t payloadSize = static_cast<uint16_t>(packet->payload.size());
+                std::vector<uint8_t> encodeFrom(const FlightProxy::Core::MspPacket &packet) override
+                {
+                    std::vector<uint8_t> buffer(kHeaderSize + packet.payload.size() + 1);
+                    writeHeader(packet, buffer.data());
 
-                    // Command (Little-Endian)
-                    buffer.push_back(static_cast<uint8_t>(cmd & 0xFF));
-                    buffer.push_back(static_cast<uint8_t>((cmd >> 8) & 0xFF));
+                    // Payload
+                    std::copy(packet.payload.begin(), packet.payload.end(), buffer.begin() + kHeaderSize);
 
-                    // Payload Size (Little-Endian)
-                    buffer.push_back(static_cast<uint8_t>(payloadSize & 0xFF));
-                    buffer.push_back(static_cast<uint8_t>((payloadSize >> 8) & 0xFF));
+                    buffer.back() = checksum(buffer.data(), packet);
+                    return buffer;
+                }
 
-                    // Payload
-                    buffer.insert(buffer.end(), packet->payload.begin(), packet->payload.end());
+                // Cabecera y CRC en 'scratch'; el payload se envía desde el propio paquete
+                size_t encodeGather(const FlightProxy::Core::MspPacket &packet, uint8_t *scratch,
+                                    Transport::IoSlice *slices) override
+                {
+                    writeHeader(packet, scratch);
+                    scratch[kHeaderSize] = checksum(scratch, packet);
 
-                    // Calcular Checksum (CRC8 DVB-S2)
-                    // Se calcula sobre (Flag, Cmd, Size, Payload)
-                    uint8_t checksum = 0;
-                    for (size_t i = 3; i < buffer.size(); ++i)
+                    size_t count = 0;
+                    slices[count].data = scratch;
+                    slices[count++].len = kHeaderSize;
+                    if (!packet.payload.empty())
                     {
-                        checksum = Detail::crc8_dvb_s2(checksum, buffer[i]);
+                        slices[count].data = packet.payload.data();
+                        slices[count++].len = packet.payload.size();
                     }
-                    buffer.push_back(checksum);
+                    slices[count].data = scratch + kHeaderSize;
+                    slices[count++].len = 1;
+                    return count;
+                }
 
-                    return buffer;
+            private:
+                static constexpr size_t kHeaderSize = 8; // '$' 'X' dir flag cmd(2) size(2)
+
+                static void writeHeader(const FlightProxy::Core::MspPacket &packet, uint8_t *out)
+                {
+                    uint16_t cmd = packet.command;
+                    uint16_t payloadSize = static_cast<uint16_t>(packet.payload.size());
+
+                    out[0] = '$';
+                    out[1] = 'X';
+                    out[2] = packet.direction; // '<' o '>'
+                    out[3] = 0;                // Flag (siempre 0)
+
+                    // Command (Little-Endian)
+                    out[4] = static_cast<uint8_t>(cmd & 0xFF);
+                    out[5] = static_cast<uint8_t>((cmd >> 8) & 0xFF);
+
+                    // Payload Size (Little-Endian)
+                    out[6] = static_cast<uint8_t>(payloadSize & 0xFF);
+                    out[7] = static_cast<uint8_t>((payloadSize >> 8) & 0xFF);
+                }
+
+                // Calcular Checksum (CRC8 DVB-S2)
+                // Se calcula sobre (Flag, Cmd, Size, Payload)
+                static uint8_t checksum(const uint8_t *header, const FlightProxy::Core::MspPacket &packet)
+                {
+                    uint8_t crc = 0;
+                    for (size_t i = 3; i < kHeaderSize; ++i)
+                    {
+                        crc = Detail::crc8_dvb_s2(crc, header[i]);
+                    }
+                    for (uint8_t byte : packet.payload)
+                    {
+                        crc = Detail::crc8_dvb_s2(crc, byte);
+                    }
+                    return crc;
                 }
             };
 
@@ -115,9 +157,27 @@ namespace FlightProxy
                 uint8_t calculatedChecksum_ = 0;
                 std::function<void(std::unique_ptr<const FlightProxy::Core::MspPacket>)> onPacketHandler_;
 
+                // Conservar los bytes de la trama para reenviarla tal cual (passthrough)
+                bool keepRawFrame_ = false;
+                std::vector<uint8_t> rawBuffer_;
+
+                // Bloque que se está procesando en feedChunk() (nullptr en feed())
+                static constexpr size_t kNoFrameStart = static_cast<size_t>(-1);
+                const Utils::ByteView *chunk_ = nullptr;
+                size_t chunkPos_ = 0;
+                size_t chunkFrameStart_ = kNoFrameStart; // La trama empezó en este bloque
+
+                bool frameInChunk() const { return chunk_ != nullptr && chunkFrameStart_ != kNoFrameStart; }
+
                 // Procesa un solo byte
                 void parse(uint8_t byte)
                 {
+                    // Si la trama está entera en el bloque se recorta al final, sin copiarla
+                    if (keepRawFrame_ && state_ != ParseState::IDLE && !frameInChunk())
+                    {
+                        rawBuffer_.push_back(byte);
+                    }
+
                     switch (state_)
                     {
                     case ParseState::IDLE:
@@ -125,6 +185,14 @@ namespace FlightProxy
                         {
                             // FP_LOG_D("MspDecoder", "Inicio de paquete MSP detectado");
                             reset(); // Iniciar un paquete nuevo y limpio
+                            if (chunk_ != nullptr)
+                            {
+                                chunkFrameStart_ = chunkPos_;
+                            }
+                            else if (keepRawFrame_)
+                            {
+                                rawBuffer_.push_back(byte);
+                            }
                             state_ = ParseState::HEADER_X;
                         }
                         break;
@@ -215,7 +283,15 @@ namespace FlightProxy
                             if (onPacketHandler_)
                             {
                                 // FP_LOG_D("MspDecoder", "Llamando al handler de paquete MSP");
-                                onPacketHandler_(std::make_unique<FlightProxy::Core::MspPacket>(workingPacket_));
+                                if (keepRawFrame_ && frameInChunk())
+                                {
+                                    workingPacket_.rawFrame = chunk_->slice(chunkFrameStart_, chunkPos_ + 1 - chunkFrameStart_);
+                                }
+                                else if (keepRawFrame_)
+                                {
+                                    workingPacket_.rawFrame = Utils::ByteView::fromVector(std::move(rawBuffer_));
+                                }
+                                onPacketHandler_(std::make_unique<FlightProxy::Core::MspPacket>(std::move(workingPacket_)));
                             }
                         }
                         // Siempre resetear, haya sido bueno o malo el checksum
@@ -225,7 +301,8 @@ namespace FlightProxy
                 }
 
             public:
-                MspDecoder()
+                // keepRawFrame: cada paquete lleva también su trama original (MspPacket::rawFrame)
+                explicit MspDecoder(bool keepRawFrame = false) : keepRawFrame_(keepRawFrame)
                 {
                     reset();
                 }
@@ -238,6 +315,49 @@ namespace FlightProxy
                     }
                 }
 
+                /**
+                 * @brief Como feed(), pero si el payload (o la trama entera) está dentro del
+                 * bloque, el paquete apunta al bloque en lugar de copiar los bytes.
+                 */
+                void feedChunk(const Utils::ByteView &chunk) override
+                {
+                    const uint8_t *data = chunk.data();
+                    size_t len = chunk.size();
+                    chunk_ = &chunk;
+                    chunkFrameStart_ = kNoFrameStart;
+
+                    for (chunkPos_ = 0; chunkPos_ < len; ++chunkPos_)
+                    {
+                        if (state_ == ParseState::PAYLOAD && payloadCounter_ == 0 &&
+                            chunkPos_ + payloadSize_ <= len)
+                        {
+                            // Payload completo en el bloque: solo se lee para el CRC
+                            for (size_t i = 0; i < payloadSize_; ++i)
+                            {
+                                calculatedChecksum_ = Detail::crc8_dvb_s2(calculatedChecksum_, data[chunkPos_ + i]);
+                            }
+                            if (keepRawFrame_ && !frameInChunk())
+                            {
+                                rawBuffer_.insert(rawBuffer_.end(), data + chunkPos_, data + chunkPos_ + payloadSize_);
+                            }
+                            workingPacket_.payload = chunk.slice(chunkPos_, payloadSize_);
+                            payloadCounter_ = payloadSize_;
+                            chunkPos_ += payloadSize_ - 1;
+                            state_ = ParseState::CHECKSUM;
+                            continue;
+                        }
+                        parse(data[chunkPos_]);
+                    }
+
+                    // Trama a medias: lo ya recibido pasa al buffer propio para el siguiente bloque
+                    if (keepRawFrame_ && frameInChunk() && state_ != ParseState::IDLE)
+                    {
+                        rawBuffer_.assign(data + chunkFrameStart_, data + len);
+                    }
+                    chunk_ = nullptr;
+                    chunkFrameStart_ = kNoFrameStart;
+                }
+
                 void onPacket(std::function<void(std::unique_ptr<const FlightProxy::Core::MspPacket>)> handler) override
                 {
                     onPacketHandler_ = handler;
@@ -253,6 +373,8 @@ namespace FlightProxy
                     tempCmd_ = 0;
                     tempSize_ = 0;
                     workingPacket_.payload.clear();
+                    workingPacket_.rawFrame.reset();
+                    rawBuffer_.clear();
                 }
             };
         }
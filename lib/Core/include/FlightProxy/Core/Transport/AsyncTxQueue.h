@@ -0,0 +1,334 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Transport/IoSlice.h"
+#include "FlightProxy/Core/Utils/ByteView.h"
+#include "FlightProxy/Core/Utils/RxChunkPool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Transport
+        {
+            struct AsyncTxConfig
+            {
+                size_t capacityBytes = 8192; // Máximo de bytes en cola (incluido el bloque en curso)
+                size_t highWatermark = 6144; // Al superarla se avisa con onHigh (backpressure)
+                size_t lowWatermark = 2048;  // Al bajar de ella se avisa con onLow (writable)
+                size_t maxFrames = 64;       // Tramas en cola como máximo (huecos reservados al crear)
+                size_t copyBlockBytes = 256; // Bloques para las tramas que hay que copiar
+                size_t copyBlocks = 16;
+            };
+
+            /**
+             * @brief Cola de transmisión acotada para transportes con envío asíncrono.
+             *
+             * Cada trama en cola es una vista con dueño compartido (ByteView): las tramas
+             * que ya lo tienen (p. ej. la SharedFrame de una difusión) se encolan sin copiar
+             * ni reservar memoria (pushFrame); las que llegan como puntero suelto se copian
+             * una vez a un bloque del pool de la cola (push/pushv/pushWith), y solo van al
+             * heap si no caben en un bloque o no queda ninguno libre.
+             *
+             * Una tarea escritora del transporte saca las tramas por lotes (popBatch), las
+             * envía con E/S dispersa apuntando a esas mismas vistas y confirma con done().
+             * Las marcas alta y baja se notifican una vez por cruce, fuera del mutex, para
+             * que el canal aplique backpressure o descarte.
+             */
+            class AsyncTxQueue
+            {
+            public:
+                explicit AsyncTxQueue(const AsyncTxConfig &config = AsyncTxConfig())
+                    : config_(config),
+                      m_mutex(Core::OSAL::Factory::createMutex("AsyncTxQueue")),
+                      events_(Core::OSAL::Factory::createEventFlags()),
+                      copyPool_(config.copyBlockBytes, config.copyBlocks, "TxCopyPool")
+                {
+                    if (config_.highWatermark > config_.capacityBytes)
+                        config_.highWatermark = config_.capacityBytes;
+                    if (config_.lowWatermark > config_.highWatermark)
+                        config_.lowWatermark = config_.highWatermark;
+                    if (config_.maxFrames == 0)
+                        config_.maxFrames = 1;
+                    frames_.resize(config_.maxFrames);
+                }
+
+                std::function<void()> onHigh;
+                std::function<void()> onLow;
+
+                /**
+                 * @brief Encola una copia de los datos. Nunca bloquea.
+                 * @return false si no caben o la cola está cerrada (no se encola nada).
+                 */
+                bool push(const uint8_t *data, size_t len)
+                {
+                    IoSlice slice;
+                    slice.data = data;
+                    slice.len = len;
+                    return pushv(&slice, 1);
+                }
+
+                // Encola una trama en varios trozos, copiada una sola vez a su bloque
+                bool pushv(const IoSlice *slices, size_t count)
+                {
+                    return pushWith(totalLength(slices, count), [slices, count](uint8_t *out)
+                                    { gatherInto(slices, count, out); });
+                }
+
+                /**
+                 * @brief Encola la trama sin copiarla: la cola comparte su dueño hasta que
+                 * el escritor la haya enviado. Nunca bloquea.
+                 * @return false si no cabe o la cola está cerrada.
+                 */
+                bool pushFrame(const Utils::ByteView &frame)
+                {
+                    if (frame.empty())
+                        return true;
+
+                    bool crossedHigh = false;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        if (!reserve(frame.size(), crossedHigh))
+                            return false;
+                        reserved_--;
+                        append(frame);
+                    }
+
+                    events_->set(kDataReady);
+
+                    if (crossedHigh && onHigh)
+                        onHigh();
+                    return true;
+                }
+
+                /**
+                 * @brief Reserva 'len' bytes en un bloque de la cola, deja que 'writer' los
+                 * rellene en su sitio (sin mutex) y los confirma. Si la cola se cierra
+                 * mientras tanto el bloque se descarta al confirmar.
+                 * @return false si no caben o la cola está cerrada ('writer' no se llama).
+                 */
+                bool pushWith(size_t len, const std::function<void(uint8_t *)> &writer)
+                {
+                    if (len == 0)
+                        return true;
+
+                    uint32_t epoch;
+                    bool crossedHigh = false;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        if (!reserve(len, crossedHigh))
+                            return false;
+                        epoch = epoch_;
+                    }
+
+                    std::shared_ptr<Utils::RxChunk> block;
+                    if (len <= copyPool_.chunkSize())
+                    {
+                        block = copyPool_.acquire();
+                    }
+                    else
+                    {
+                        oversized_++;
+                        block = std::make_shared<Utils::RxChunk>(len);
+                    }
+                    writer(block->bytes.data());
+                    block->len = len;
+
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        if (epoch != epoch_)
+                            return false; // Se cerró mientras escribíamos: close() ya descontó
+                        reserved_--;
+                        append(Utils::RxChunk::view(block, 0, len));
+                    }
+
+                    events_->set(kDataReady);
+
+                    if (crossedHigh && onHigh)
+                        onHigh();
+                    return true;
+                }
+
+                /**
+                 * @brief Lado escritor: saca hasta 'maxFrames' tramas de una vez para
+                 * enviarlas con una sola llamada de E/S dispersa (writev / WSASend). Las
+                 * vistas mantienen vivos los bytes hasta que el escritor vacíe 'batch'.
+                 * @return Número de tramas en 'batch' (0 = timeout o cerrada y vacía).
+                 */
+                size_t popBatch(std::vector<Utils::ByteView> &batch, size_t maxFrames, uint32_t timeoutMs)
+                {
+                    batch.clear();
+                    for (int attempt = 0; attempt < 2; ++attempt)
+                    {
+                        {
+                            std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                            while (batch.size() < maxFrames && count_ > 0)
+                            {
+                                batch.push_back(std::move(frames_[head_]));
+                                head_ = (head_ + 1) % frames_.size();
+                                count_--;
+                            }
+                            if (!batch.empty() || closed_)
+                                return batch.size();
+                        }
+
+                        if (attempt == 0 && !events_->waitAny(kDataReady, timeoutMs))
+                            return 0;
+                    }
+                    return 0;
+                }
+
+                // Lado escritor: las tramas de 'len' bytes ya salieron (o se descartaron)
+                void done(size_t len)
+                {
+                    bool crossedLow = false;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        pendingBytes_ = (len > pendingBytes_) ? 0 : pendingBytes_ - len;
+                        if (congested_ && pendingBytes_ <= config_.lowWatermark)
+                        {
+                            congested_ = false;
+                            crossedLow = true;
+                        }
+                    }
+
+                    if (crossedLow && onLow)
+                        onLow();
+                }
+
+                // Rechaza nuevos datos, descarta lo pendiente y despierta al escritor.
+                // Si había congestión se avisa con onLow: la cola ya está vacía.
+                void close()
+                {
+                    bool crossedLow = false;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        closed_ = true;
+                        epoch_++; // Invalida las reservas en curso
+                        while (count_ > 0)
+                        {
+                            frames_[head_].reset();
+                            head_ = (head_ + 1) % frames_.size();
+                            count_--;
+                        }
+                        reserved_ = 0;
+                        pendingBytes_ = 0;
+                        crossedLow = congested_;
+                        congested_ = false;
+                    }
+                    events_->set(kDataReady);
+
+                    if (crossedLow && onLow)
+                        onLow();
+                }
+
+                // Vuelve a aceptar datos (p. ej. al reconectar un cliente)
+                void reopen()
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                    closed_ = false;
+                    events_->clear(kWriterDone); // Limpia un aviso antiguo
+                }
+
+                // El escritor avisa al salir; quien cierra el socket espera a que lo haga
+                void signalWriterDone()
+                {
+                    events_->set(kWriterDone);
+                }
+
+                bool waitWriterDone(uint32_t timeoutMs)
+                {
+                    return events_->waitAny(kWriterDone, timeoutMs) != 0;
+                }
+
+                size_t pendingBytes() const
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                    return pendingBytes_;
+                }
+
+                bool isClosed() const
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                    return closed_;
+                }
+
+                bool isCongested() const
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                    return congested_;
+                }
+
+                uint32_t droppedCount() const
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                    return dropped_;
+                }
+
+                // Copias que fueron al heap: más grandes que un bloque o sin bloque libre
+                uint32_t heapCopyCount() const
+                {
+                    return oversized_.load() + copyPool_.overflowCount();
+                }
+
+            private:
+                // Con m_mutex: aparta sitio (bytes y hueco) para una trama
+                bool reserve(size_t len, bool &crossedHigh)
+                {
+                    if (closed_ || pendingBytes_ + len > config_.capacityBytes ||
+                        count_ + reserved_ >= frames_.size())
+                    {
+                        dropped_++;
+                        return false;
+                    }
+
+                    // Los bytes reservados ya cuentan para la capacidad y las marcas
+                    pendingBytes_ += len;
+                    reserved_++;
+
+                    if (!congested_ && pendingBytes_ >= config_.highWatermark)
+                    {
+                        congested_ = true;
+                        crossedHigh = true;
+                    }
+                    return true;
+                }
+
+                // Con m_mutex
+                void append(Utils::ByteView frame)
+                {
+                    frames_[(head_ + count_) % frames_.size()] = std::move(frame);
+                    count_++;
+                }
+
+                AsyncTxConfig config_;
+                std::unique_ptr<Core::OSAL::IMutex> m_mutex;
+                // Un solo grupo de flags para los dos avisos (los esperan tareas distintas)
+                static constexpr Core::OSAL::IEventFlags::Bits kDataReady = 1u << 0;
+                static constexpr Core::OSAL::IEventFlags::Bits kWriterDone = 1u << 1;
+                std::unique_ptr<Core::OSAL::IEventFlags> events_;
+
+                // Mismos bloques reutilizables que en recepción: libres cuando solo los tiene el pool
+                Utils::RxChunkPool copyPool_;
+                std::atomic<uint32_t> oversized_{0};
+
+                std::vector<Utils::ByteView> frames_; // Anillo de tramas, tamaño fijo
+                size_t head_ = 0;
+                size_t count_ = 0;
+                size_t reserved_ = 0; // Huecos apartados por pushWith aún sin confirmar
+                size_t pendingBytes_ = 0;
+                bool congested_ = false;
+                bool closed_ = false;
+                uint32_t epoch_ = 0;
+                uint32_t dropped_ = 0;
+            };
+        }
+    }
+}
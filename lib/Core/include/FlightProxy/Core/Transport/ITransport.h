@@ -1,6 +1,9 @@
 #pragma once
+#include "FlightProxy/Core/Transport/IoSlice.h"
+#include "FlightProxy/Core/Utils/RxChunkPool.h"
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 namespace FlightProxy
 {
@@ -17,9 +20,81 @@ namespace FlightProxy
                 virtual void close() = 0;
                 virtual void send(const uint8_t *data, size_t len) = 0;
 
+                /**
+                 * @brief Envío que nunca bloquea: los transportes con cola de TX copian los
+                 * datos y los envía su propia tarea. Devuelve false si no caben (se pierden).
+                 * Por defecto envía en el momento con send().
+                 */
+                virtual bool trySend(const uint8_t *data, size_t len)
+                {
+                    send(data, len);
+                    return true;
+                }
+
+                /**
+                 * @brief Envía una trama con dueño compartido (p. ej. la SharedFrame de una
+                 * difusión). Los transportes con cola de TX la encolan sin copiarla: la vista
+                 * mantiene vivos los bytes hasta que salen. Por defecto va por trySend().
+                 */
+                virtual bool trySendFrame(const Utils::ByteView &frame)
+                {
+                    return trySend(frame.data(), frame.size());
+                }
+
+                /**
+                 * @brief Envía una trama repartida en varios trozos (cabecera, payload, CRC...)
+                 * sin aplanarla antes. Los transportes con E/S dispersa (writev, sendmsg,
+                 * WSASend) la envían tal cual; por defecto se junta en un buffer y va por send().
+                 */
+                virtual void sendv(const IoSlice *slices, size_t count)
+                {
+                    if (count == 1)
+                    {
+                        send(slices[0].data, slices[0].len);
+                        return;
+                    }
+                    std::vector<uint8_t> flat(totalLength(slices, count));
+                    gatherInto(slices, count, flat.data());
+                    send(flat.data(), flat.size());
+                }
+
+                // Como sendv() pero sin bloquear (mismas reglas que trySend)
+                virtual bool trySendv(const IoSlice *slices, size_t count)
+                {
+                    sendv(slices, count);
+                    return true;
+                }
+
+                // Bytes esperando en la cola de TX (0 si el transporte no tiene cola)
+                virtual size_t pendingTxBytes() const { return 0; }
+
                 std::function<void()> onOpen;
                 std::function<void(const uint8_t *, size_t)> onData;
+
+                // Si se asigna, lo recibido llega como vista del bloque de recepción en lugar
+                // de por onData; el consumidor puede quedársela sin copiar los bytes.
+                std::function<void(const Utils::ByteView &)> onChunk;
                 std::function<void()> onClose;
+
+                // La cola de TX superó la marca alta: el par va lento, conviene frenar o descartar
+                std::function<void()> onBackpressure;
+                // La cola bajó de la marca baja tras un onBackpressure: se puede volver a enviar
+                std::function<void()> onWritable;
+
+            protected:
+                // Entrega 'len' bytes leídos en el bloque por onChunk o, si no hay, por onData
+                void deliverRx(const std::shared_ptr<Utils::RxChunk> &chunk, size_t len)
+                {
+                    chunk->len = len;
+                    if (onChunk)
+                    {
+                        onChunk(Utils::RxChunk::view(chunk, 0, len));
+                    }
+                    else if (onData)
+                    {
+                        onData(chunk->bytes.data(), len);
+                    }
+                }
             };
         }
     }
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Transport
+        {
+            // Trozo de una trama repartida en varios buffers (estilo iovec)
+            struct IoSlice
+            {
+                const uint8_t *data = nullptr;
+                size_t len = 0;
+            };
+
+            inline size_t totalLength(const IoSlice *slices, size_t count)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    total += slices[i].len;
+                }
+                return total;
+            }
+
+            // Copia los trozos seguidos en 'out' (debe tener totalLength() bytes)
+            inline void gatherInto(const IoSlice *slices, size_t count, uint8_t *out)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (slices[i].len == 0)
+                        continue;
+                    std::memcpy(out, slices[i].data, slices[i].len);
+                    out += slices[i].len;
+                }
+            }
+        }
+    }
+}
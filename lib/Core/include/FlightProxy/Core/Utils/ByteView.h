@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Vista inmutable sobre bytes con propiedad compartida.
+             *
+             * Apunta a un trozo de un buffer (p. ej. un bloque de recepción del
+             * transporte) y mantiene vivo al dueño mientras exista la vista o una copia.
+             * Copiar o recortar la vista no copia los bytes ni reserva memoria (usa el
+             * constructor de aliasing de shared_ptr).
+             */
+            class ByteView
+            {
+            public:
+                ByteView() = default;
+                ByteView(std::nullptr_t) {}
+
+                ByteView(std::shared_ptr<const void> owner, const uint8_t *data, size_t size)
+                    : owner_(std::move(owner)), data_(data), size_(size) {}
+
+                ByteView(const ByteView &) = default;
+                ByteView &operator=(const ByteView &) = default;
+
+                // La vista movida queda vacía (no solo sin dueño)
+                ByteView(ByteView &&other) noexcept
+                    : owner_(std::move(other.owner_)), data_(other.data_), size_(other.size_)
+                {
+                    other.data_ = nullptr;
+                    other.size_ = 0;
+                }
+
+                ByteView &operator=(ByteView &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        owner_ = std::move(other.owner_);
+                        data_ = other.data_;
+                        size_ = other.size_;
+                        other.data_ = nullptr;
+                        other.size_ = 0;
+                    }
+                    return *this;
+                }
+
+                // La vista pasa a ser dueña del vector (una reserva para el bloque de control)
+                static ByteView fromVector(std::vector<uint8_t> bytes)
+                {
+                    auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+                    const uint8_t *data = owner->data();
+                    size_t size = owner->size();
+                    return ByteView(std::move(owner), data, size);
+                }
+
+                const uint8_t *data() const { return data_; }
+                size_t size() const { return size_; }
+                bool empty() const { return size_ == 0; }
+                const uint8_t *begin() const { return data_; }
+                const uint8_t *end() const { return data_ + size_; }
+                uint8_t operator[](size_t index) const { return data_[index]; }
+
+                // Nula si no apunta a nada (como el shared_ptr que sustituye)
+                explicit operator bool() const { return owner_ != nullptr; }
+
+                void reset()
+                {
+                    owner_.reset();
+                    data_ = nullptr;
+                    size_ = 0;
+                }
+
+                // Sub-vista que comparte el mismo dueño
+                ByteView slice(size_t offset, size_t length) const
+                {
+                    if (offset > size_)
+                        offset = size_;
+                    if (length > size_ - offset)
+                        length = size_ - offset;
+                    return ByteView(owner_, data_ + offset, length);
+                }
+
+                std::vector<uint8_t> toVector() const
+                {
+                    return std::vector<uint8_t>(begin(), end());
+                }
+
+                // Copia propia de los bytes: suelta el buffer original (p. ej. antes de cachear)
+                ByteView detached() const
+                {
+                    return owner_ ? fromVector(toVector()) : ByteView();
+                }
+
+                const std::shared_ptr<const void> &owner() const { return owner_; }
+
+            private:
+                std::shared_ptr<const void> owner_;
+                const uint8_t *data_ = nullptr;
+                size_t size_ = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/IBlockPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Pool de bloques fijos lock-free (pila de Treiber).
+             *
+             * La cabeza de la lista libre es un único atomic de 32 bits: índice del
+             * bloque (16 bits) y etiqueta (16 bits) que cambia en cada pop para evitar
+             * ABA. Así el CAS es nativo también en el ESP32, sin secciones críticas.
+             * Los enlaces van en un array aparte para no leer memoria de bloques ya
+             * entregados. Máximo 65535 bloques.
+             *
+             * La memoria la reserva la plataforma (ver OSALFactory::createBlockPool).
+             */
+            class FixedBlockPool : public Core::OSAL::IBlockPool
+            {
+            public:
+                using StorageAlloc = void *(*)(size_t bytes);
+                using StorageFree = void (*)(void *storage);
+
+                static constexpr size_t kMaxBlocks = 0xFFFF;
+
+                FixedBlockPool(size_t blockSize, size_t blockCount, StorageAlloc storageAlloc, StorageFree storageFree)
+                    : blockSize_(alignUp(blockSize < sizeof(void *) ? sizeof(void *) : blockSize)),
+                      blockCount_(blockCount > kMaxBlocks ? kMaxBlocks : blockCount),
+                      storageFree_(storageFree),
+                      next_(new std::atomic<uint16_t>[blockCount_ > 0 ? blockCount_ : 1])
+                {
+                    storage_ = static_cast<uint8_t *>(storageAlloc(blockSize_ * blockCount_));
+                    if (!storage_)
+                        blockCount_ = 0; // Sin memoria: el pool queda vacío y allocate() devuelve nullptr
+
+                    for (size_t i = 0; i < blockCount_; ++i)
+                    {
+                        next_[i].store(static_cast<uint16_t>(i + 1 < blockCount_ ? i + 1 : kNil), std::memory_order_relaxed);
+                    }
+                    head_.store(pack(blockCount_ > 0 ? 0 : kNil, 0), std::memory_order_release);
+                }
+
+                ~FixedBlockPool() override
+                {
+                    if (storage_ && storageFree_)
+                        storageFree_(storage_);
+                }
+
+                FixedBlockPool(const FixedBlockPool &) = delete;
+                FixedBlockPool &operator=(const FixedBlockPool &) = delete;
+
+                void *allocate() override
+                {
+                    uint32_t head = head_.load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        uint16_t index = indexOf(head);
+                        if (index == kNil)
+                        {
+                            exhausted_.fetch_add(1, std::memory_order_relaxed);
+                            return nullptr;
+                        }
+
+                        uint16_t next = next_[index].load(std::memory_order_relaxed);
+                        uint32_t newHead = pack(next, static_cast<uint16_t>(tagOf(head) + 1));
+                        if (head_.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                            trackAllocation();
+                            return storage_ + static_cast<size_t>(index) * blockSize_;
+                        }
+                    }
+                }
+
+                void deallocate(void *block) override
+                {
+                    if (!owns(block))
+                        return;
+
+                    uint16_t index = static_cast<uint16_t>((static_cast<uint8_t *>(block) - storage_) / blockSize_);
+                    uint32_t head = head_.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        next_[index].store(indexOf(head), std::memory_order_relaxed);
+                        uint32_t newHead = pack(index, tagOf(head));
+                        if (head_.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+                            break;
+                    }
+                    inUse_.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                bool owns(const void *ptr) const override
+                {
+                    const uint8_t *p = static_cast<const uint8_t *>(ptr);
+                    return storage_ && p >= storage_ && p < storage_ + blockSize_ * blockCount_;
+                }
+
+                size_t blockSize() const override { return blockSize_; }
+
+                Core::OSAL::BlockPoolStats getStats() const override
+                {
+                    Core::OSAL::BlockPoolStats stats;
+                    stats.blockSize = blockSize_;
+                    stats.blockCount = blockCount_;
+                    stats.inUse = inUse_.load(std::memory_order_relaxed);
+                    stats.highWatermark = highWatermark_.load(std::memory_order_relaxed);
+                    stats.exhausted = exhausted_.load(std::memory_order_relaxed);
+                    return stats;
+                }
+
+            private:
+                static constexpr uint16_t kNil = 0xFFFF;
+
+                static size_t alignUp(size_t size)
+                {
+                    const size_t align = alignof(std::max_align_t);
+                    return (size + align - 1) & ~(align - 1);
+                }
+
+                static uint32_t pack(uint16_t index, uint16_t tag) { return (static_cast<uint32_t>(tag) << 16) | index; }
+                static uint16_t indexOf(uint32_t head) { return static_cast<uint16_t>(head & 0xFFFF); }
+                static uint16_t tagOf(uint32_t head) { return static_cast<uint16_t>(head >> 16); }
+
+                void trackAllocation()
+                {
+                    size_t used = inUse_.fetch_add(1, std::memory_order_relaxed) + 1;
+                    size_t prev = highWatermark_.load(std::memory_order_relaxed);
+                    while (used > prev && !highWatermark_.compare_exchange_weak(prev, used, std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                size_t blockSize_;
+                size_t blockCount_;
+                StorageFree storageFree_;
+                uint8_t *storage_ = nullptr;
+                std::unique_ptr<std::atomic<uint16_t>[]> next_;
+
+                std::atomic<uint32_t> head_{0};
+                std::atomic<size_t> inUse_{0};
+                std::atomic<size_t> highWatermark_{0};
+                std::atomic<uint32_t> exhausted_{0};
+            };
+        }
+    }
+}
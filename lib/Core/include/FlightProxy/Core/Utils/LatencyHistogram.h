@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Histograma de duraciones en potencias de dos de microsegundos.
+             *
+             * El bucket i cuenta las duraciones en [2^(i-1), 2^i) us y el 0 las de menos
+             * de 1 us. Todo son atómicos de 32 bits con orden relaxed (en el Xtensa los
+             * de 64 bits no son lock-free), así que record() no bloquea y lo pueden
+             * llamar varias tareas a la vez. totalUs se desborda tras ~71 minutos
+             * acumulados: usar reset() entre volcados si se mide algo largo.
+             */
+            class LatencyHistogram
+            {
+            public:
+                static constexpr size_t kBuckets = 24; // Hasta ~8 s; lo demás al último
+
+                LatencyHistogram() = default;
+                LatencyHistogram(const LatencyHistogram &) = delete;
+                LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+                void record(uint32_t us)
+                {
+                    buckets_[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+                    count_.fetch_add(1, std::memory_order_relaxed);
+                    totalUs_.fetch_add(us, std::memory_order_relaxed);
+
+                    uint32_t prev = maxUs_.load(std::memory_order_relaxed);
+                    while (us > prev && !maxUs_.compare_exchange_weak(prev, us, std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                void reset()
+                {
+                    for (auto &bucket : buckets_)
+                        bucket.store(0, std::memory_order_relaxed);
+                    count_.store(0, std::memory_order_relaxed);
+                    totalUs_.store(0, std::memory_order_relaxed);
+                    maxUs_.store(0, std::memory_order_relaxed);
+                }
+
+                uint32_t count() const { return count_.load(std::memory_order_relaxed); }
+                uint32_t totalUs() const { return totalUs_.load(std::memory_order_relaxed); }
+                uint32_t maxUs() const { return maxUs_.load(std::memory_order_relaxed); }
+                uint32_t bucket(size_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+
+                /**
+                 * @brief Percentil aproximado (cota superior de su bucket, en us).
+                 * @param permille 500 = mediana, 990 = p99...
+                 */
+                uint32_t percentileUs(uint32_t permille) const
+                {
+                    uint32_t total = 0;
+                    uint32_t counts[kBuckets];
+                    for (size_t i = 0; i < kBuckets; ++i)
+                    {
+                        counts[i] = bucket(i);
+                        total += counts[i];
+                    }
+                    if (total == 0)
+                        return 0;
+
+                    uint64_t target = (uint64_t(total) * permille + 999) / 1000;
+                    uint64_t seen = 0;
+                    for (size_t i = 0; i < kBuckets; ++i)
+                    {
+                        seen += counts[i];
+                        if (seen >= target && counts[i] > 0)
+                            return i + 1 < kBuckets ? (uint32_t(1) << i) : maxUs();
+                    }
+                    return maxUs();
+                }
+
+            private:
+                static size_t bucketOf(uint32_t us)
+                {
+                    size_t i = 0;
+                    while (us != 0 && i + 1 < kBuckets)
+                    {
+                        us >>= 1;
+                        ++i;
+                    }
+                    return i;
+                }
+
+                std::atomic<uint32_t> count_{0};
+                std::atomic<uint32_t> totalUs_{0};
+                std::atomic<uint32_t> maxUs_{0};
+                std::atomic<uint32_t> buckets_[kBuckets] = {};
+            };
+        }
+    }
+}
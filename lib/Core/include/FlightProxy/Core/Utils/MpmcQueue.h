@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Cola acotada lock-free multi-productor (algoritmo de D. Vyukov).
+             *
+             * Cada celda lleva un número de secuencia que indica si está libre para
+             * el productor o lista para el consumidor, de modo que push/pop solo hacen
+             * un CAS sobre su índice y nunca bloquean. Admite también varios
+             * consumidores (lo usamos para descartar el más antiguo desde el productor).
+             *
+             * La capacidad se redondea a la siguiente potencia de dos.
+             * T debe ser construible por defecto y asignable por movimiento.
+             */
+            template <typename T>
+            class MpmcQueue
+            {
+            public:
+                explicit MpmcQueue(size_t capacity)
+                    : mask_(roundUpPow2(capacity < 2 ? 2 : capacity) - 1),
+                      buffer_(new Cell[mask_ + 1])
+                {
+                    for (size_t i = 0; i <= mask_; ++i)
+                    {
+                        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+                    }
+                    enqueuePos_.store(0, std::memory_order_relaxed);
+                    dequeuePos_.store(0, std::memory_order_relaxed);
+                }
+
+                MpmcQueue(const MpmcQueue &) = delete;
+                MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+                /**
+                 * @brief Intenta encolar sin bloquear.
+                 * @return false si la cola está llena (el ítem no se consume).
+                 */
+                bool tryPush(T &&item) { return emplace(std::move(item)); }
+                bool tryPush(const T &item) { return emplace(item); }
+
+                /**
+                 * @brief Intenta desencolar sin bloquear.
+                 * @return false si la cola está vacía.
+                 */
+                bool tryPop(T &item)
+                {
+                    Cell *cell;
+                    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+                    for (;;)
+                    {
+                        cell = &buffer_[pos & mask_];
+                        size_t seq = cell->sequence.load(std::memory_order_acquire);
+                        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                        if (diff == 0)
+                        {
+                            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if (diff < 0)
+                        {
+                            return false; // Vacía
+                        }
+                        else
+                        {
+                            pos = dequeuePos_.load(std::memory_order_relaxed);
+                        }
+                    }
+                    item = std::move(cell->data);
+                    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+
+                size_t capacity() const { return mask_ + 1; }
+
+                /**
+                 * @brief Número aproximado de ítems (solo para estadísticas).
+                 */
+                size_t sizeApprox() const
+                {
+                    size_t enq = enqueuePos_.load(std::memory_order_relaxed);
+                    size_t deq = dequeuePos_.load(std::memory_order_relaxed);
+                    return (enq >= deq) ? (enq - deq) : 0;
+                }
+
+                bool emptyApprox() const { return sizeApprox() == 0; }
+
+            private:
+                static constexpr size_t kCacheLine = 64;
+
+                struct Cell
+                {
+                    std::atomic<size_t> sequence;
+                    T data;
+                };
+
+                template <typename U>
+                bool emplace(U &&item)
+                {
+                    Cell *cell;
+                    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+                    for (;;)
+                    {
+                        cell = &buffer_[pos & mask_];
+                        size_t seq = cell->sequence.load(std::memory_order_acquire);
+                        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                        if (diff == 0)
+                        {
+                            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if (diff < 0)
+                        {
+                            return false; // Llena
+                        }
+                        else
+                        {
+                            pos = enqueuePos_.load(std::memory_order_relaxed);
+                        }
+                    }
+                    cell->data = std::forward<U>(item);
+                    cell->sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+
+                static size_t roundUpPow2(size_t v)
+                {
+                    size_t p = 1;
+                    while (p < v)
+                        p <<= 1;
+                    return p;
+                }
+
+                const size_t mask_;
+                std::unique_ptr<Cell[]> buffer_;
+
+                // Productores y consumidores en líneas de caché distintas
+                alignas(kCacheLine) std::atomic<size_t> enqueuePos_;
+                alignas(kCacheLine) std::atomic<size_t> dequeuePos_;
+            };
+
+        } // namespace Utils
+    } // namespace Core
+} // namespace FlightProxy
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "FlightProxy/Core/Utils/ByteView.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Payload de un paquete: bytes propios o vista sobre un buffer ajeno.
+             *
+             * Los paquetes que crea la aplicación llevan su propio vector (como siempre).
+             * Los que decodifica un decoder desde un bloque de recepción pueden apuntar a
+             * ese bloque sin copiar (ByteView). La lectura es igual en ambos casos.
+             */
+            class PayloadBytes
+            {
+            public:
+                PayloadBytes() = default;
+                PayloadBytes(std::vector<uint8_t> bytes) : owned_(std::move(bytes)) {}
+                PayloadBytes(std::initializer_list<uint8_t> bytes) : owned_(bytes) {}
+                PayloadBytes(ByteView view) : view_(std::move(view)) {}
+
+                const uint8_t *data() const { return view_ ? view_.data() : owned_.data(); }
+                size_t size() const { return view_ ? view_.size() : owned_.size(); }
+                bool empty() const { return size() == 0; }
+                const uint8_t *begin() const { return data(); }
+                const uint8_t *end() const { return data() + size(); }
+                uint8_t operator[](size_t index) const { return data()[index]; }
+
+                // true si apunta a un buffer ajeno (lo mantiene vivo)
+                bool isView() const { return static_cast<bool>(view_); }
+
+                // --- Construcción byte a byte (decoders) ---
+                void reserve(size_t n) { owned_.reserve(n); }
+                void push_back(uint8_t byte) { owned_.push_back(byte); }
+                void clear()
+                {
+                    owned_.clear();
+                    view_.reset();
+                }
+
+                std::vector<uint8_t> toVector() const
+                {
+                    return view_ ? view_.toVector() : owned_;
+                }
+
+                // Pasa a bytes propios y suelta el buffer ajeno (p. ej. antes de cachear)
+                void detach()
+                {
+                    if (view_)
+                    {
+                        owned_ = view_.toVector();
+                        view_.reset();
+                    }
+                }
+
+                friend bool operator==(const PayloadBytes &a, const PayloadBytes &b)
+                {
+                    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+                }
+                friend bool operator==(const std::vector<uint8_t> &a, const PayloadBytes &b)
+                {
+                    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+                }
+                friend bool operator==(const PayloadBytes &a, const std::vector<uint8_t> &b)
+                {
+                    return b == a;
+                }
+
+            private:
+                std::vector<uint8_t> owned_;
+                ByteView view_;
+            };
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/IBlockPool.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Adaptador de allocator estándar sobre un IBlockPool.
+             *
+             * Las peticiones de un solo objeto que caben en un bloque salen del pool; el
+             * resto (arrays, bloques demasiado grandes o pool agotado) van al heap. Así
+             * sirve también para allocate_shared, que pide objeto + bloque de control.
+             * El pool debe vivir más que todo lo reservado con él.
+             */
+            template <typename T>
+            class PoolAllocator
+            {
+            public:
+                using value_type = T;
+
+                explicit PoolAllocator(std::shared_ptr<Core::OSAL::IBlockPool> pool) noexcept
+                    : pool_(std::move(pool)) {}
+
+                template <typename U>
+                PoolAllocator(const PoolAllocator<U> &other) noexcept : pool_(other.pool()) {}
+
+                T *allocate(size_t n)
+                {
+                    if (n == 1 && pool_ && sizeof(T) <= pool_->blockSize())
+                    {
+                        if (void *block = pool_->allocate())
+                            return static_cast<T *>(block);
+                    }
+                    return static_cast<T *>(::operator new(n * sizeof(T)));
+                }
+
+                void deallocate(T *ptr, size_t) noexcept
+                {
+                    if (pool_ && pool_->owns(ptr))
+                        pool_->deallocate(ptr);
+                    else
+                        ::operator delete(ptr);
+                }
+
+                const std::shared_ptr<Core::OSAL::IBlockPool> &pool() const noexcept { return pool_; }
+
+                template <typename U>
+                bool operator==(const PoolAllocator<U> &other) const noexcept { return pool_ == other.pool(); }
+                template <typename U>
+                bool operator!=(const PoolAllocator<U> &other) const noexcept { return pool_ != other.pool(); }
+
+            private:
+                std::shared_ptr<Core::OSAL::IBlockPool> pool_;
+            };
+
+            // Deleter para unique_ptr de objetos creados con makePooled()
+            template <typename T>
+            struct PoolDeleter
+            {
+                std::shared_ptr<Core::OSAL::IBlockPool> pool;
+
+                void operator()(T *ptr) const
+                {
+                    if (!ptr)
+                        return;
+                    ptr->~T();
+                    PoolAllocator<T>(pool).deallocate(ptr, 1);
+                }
+            };
+
+            template <typename T>
+            using PooledPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+            // make_unique desde un pool (con vuelta al heap si no cabe o está agotado)
+            template <typename T, typename... Args>
+            PooledPtr<T> makePooled(const std::shared_ptr<Core::OSAL::IBlockPool> &pool, Args &&...args)
+            {
+                PoolAllocator<T> allocator(pool);
+                T *memory = allocator.allocate(1);
+                try
+                {
+                    return PooledPtr<T>(new (memory) T(std::forward<Args>(args)...), PoolDeleter<T>{pool});
+                }
+                catch (...)
+                {
+                    allocator.deallocate(memory, 1);
+                    throw;
+                }
+            }
+
+            // allocate_shared desde un pool: objeto y bloque de control en un solo bloque
+            template <typename T, typename... Args>
+            std::shared_ptr<T> allocateShared(const std::shared_ptr<Core::OSAL::IBlockPool> &pool, Args &&...args)
+            {
+                return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Base para tipos cuyo operator new/delete sale de un pool.
+             *
+             * Con ella 'new T', std::make_unique<T> y el deleter por defecto de unique_ptr
+             * usan el pool sin cambiar el tipo de los punteros (p. ej. unique_ptr<const
+             * MspPacket> en canales y colas). Sin pool asignado, o si está agotado, se usa
+             * el heap. El pool se asigna una vez al arrancar y no se quita mientras
+             * existan objetos.
+             */
+            template <typename Derived>
+            struct PooledAllocation
+            {
+                static void setAllocationPool(std::shared_ptr<Core::OSAL::IBlockPool> pool)
+                {
+                    poolSlot() = std::move(pool);
+                }
+
+                static const std::shared_ptr<Core::OSAL::IBlockPool> &allocationPool()
+                {
+                    return poolSlot();
+                }
+
+                static void *operator new(size_t size)
+                {
+                    const auto &pool = poolSlot();
+                    if (pool && size <= pool->blockSize())
+                    {
+                        if (void *block = pool->allocate())
+                            return block;
+                    }
+                    return ::operator new(size);
+                }
+
+                static void operator delete(void *ptr)
+                {
+                    const auto &pool = poolSlot();
+                    if (pool && pool->owns(ptr))
+                        pool->deallocate(ptr);
+                    else
+                        ::operator delete(ptr);
+                }
+
+            private:
+                static std::shared_ptr<Core::OSAL::IBlockPool> &poolSlot()
+                {
+                    static std::shared_ptr<Core::OSAL::IBlockPool> pool;
+                    return pool;
+                }
+            };
+        }
+    }
+}
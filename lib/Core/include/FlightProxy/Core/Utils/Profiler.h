@@ -0,0 +1,131 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/LatencyHistogram.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Perfilado por secciones. Solo se compila con -DFP_ENABLE_PROFILING; sin la
+// flag las macros FP_PROFILE_* no generan código.
+//
+//   void transact()
+//   {
+//       FP_PROFILE_SCOPE("DataNode.transact");
+//       ...
+//   }
+//
+//   FP_PROFILE_DUMP(); // Vuelca al log todas las secciones
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Estadísticas de un punto de medida (una por FP_PROFILE_SCOPE):
+             * un LatencyHistogram con nombre, enlazado en la lista de sitios.
+             */
+            class ProfileSite : public LatencyHistogram
+            {
+            public:
+                explicit ProfileSite(const char *name) : name_(name)
+                {
+                    // Lista intrusiva sin lock: los sitios son estáticos y nunca se quitan
+                    next_ = head().load(std::memory_order_relaxed);
+                    while (!head().compare_exchange_weak(next_, this,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                const char *name() const { return name_; }
+
+                // Recorre todos los sitios registrados
+                template <typename Fn>
+                static void forEach(Fn &&fn)
+                {
+                    for (ProfileSite *site = head().load(std::memory_order_acquire); site; site = site->next_)
+                        fn(*site);
+                }
+
+            private:
+                static std::atomic<ProfileSite *> &head()
+                {
+                    static std::atomic<ProfileSite *> instance{nullptr};
+                    return instance;
+                }
+
+                const char *name_;
+                ProfileSite *next_ = nullptr;
+            };
+
+            /**
+             * @brief Mide el tiempo entre su construcción y su destrucción.
+             */
+            class ScopedProfileTimer
+            {
+            public:
+                explicit ScopedProfileTimer(ProfileSite &site)
+                    : site_(site), startUs_(Core::OSAL::Factory::getMonotonicTimeUs())
+                {
+                }
+
+                ~ScopedProfileTimer()
+                {
+                    uint64_t elapsed = Core::OSAL::Factory::getMonotonicTimeUs() - startUs_;
+                    site_.record(elapsed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(elapsed));
+                }
+
+                ScopedProfileTimer(const ScopedProfileTimer &) = delete;
+                ScopedProfileTimer &operator=(const ScopedProfileTimer &) = delete;
+
+            private:
+                ProfileSite &site_;
+                uint64_t startUs_;
+            };
+
+            struct Profiler
+            {
+                // Una línea por sitio con actividad; con reset=true empieza una ventana nueva
+                static void dump(bool reset = false)
+                {
+                    ProfileSite::forEach([reset](ProfileSite &site)
+                                         {
+                        uint32_t count = site.count();
+                        if (count == 0)
+                            return;
+                        FP_LOG_I("Profiler", "%s: n=%u avg=%uus p50<=%uus p99<=%uus max=%uus",
+                                 site.name(), (unsigned)count, (unsigned)(site.totalUs() / count),
+                                 (unsigned)site.percentileUs(500), (unsigned)site.percentileUs(990),
+                                 (unsigned)site.maxUs());
+                        if (reset)
+                            site.reset(); });
+                }
+
+                static void reset()
+                {
+                    ProfileSite::forEach([](ProfileSite &site)
+                                         { site.reset(); });
+                }
+            };
+        }
+    }
+}
+
+#if defined(FP_ENABLE_PROFILING)
+#define FP_PROFILE_CONCAT_(a, b) a##b
+#define FP_PROFILE_CONCAT(a, b) FP_PROFILE_CONCAT_(a, b)
+#define FP_PROFILE_SCOPE(name)                                                                           \
+    static FlightProxy::Core::Utils::ProfileSite FP_PROFILE_CONCAT(fpProfileSite_, __LINE__)(name);      \
+    FlightProxy::Core::Utils::ScopedProfileTimer FP_PROFILE_CONCAT(fpProfileTimer_, __LINE__)(           \
+        FP_PROFILE_CONCAT(fpProfileSite_, __LINE__))
+#define FP_PROFILE_DUMP() FlightProxy::Core::Utils::Profiler::dump(true)
+#else
+#define FP_PROFILE_SCOPE(name) ((void)0)
+#define FP_PROFILE_DUMP() ((void)0)
+#endif
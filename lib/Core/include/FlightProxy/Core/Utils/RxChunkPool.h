@@ -0,0 +1,113 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/ByteView.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            // Bloque de recepción: el transporte lee en 'bytes' y publica 'len' bytes
+            struct RxChunk
+            {
+                explicit RxChunk(size_t capacity) : bytes(capacity) {}
+
+                std::vector<uint8_t> bytes;
+                size_t len = 0;
+
+                // Vista de los bytes recibidos; mantiene vivo el bloque
+                static ByteView view(const std::shared_ptr<RxChunk> &chunk, size_t offset, size_t length)
+                {
+                    return ByteView(chunk, chunk->bytes.data() + offset, length);
+                }
+            };
+
+            /**
+             * @brief Conjunto fijo de bloques de recepción reutilizables.
+             *
+             * Cada bloque es un shared_ptr que el pool conserva siempre: está libre cuando
+             * el pool es su único dueño (use_count == 1). Las vistas de los paquetes
+             * decodificados comparten ese mismo contador, así que el bloque vuelve al pool
+             * solo cuando se libera el último paquete que apunta a él, y acquire() no
+             * reserva memoria. Si todos están en uso se crea un bloque suelto (overflow)
+             * para no parar la recepción, y se avisa en el log (1, 2, 4, 8... veces) para
+             * poder ajustar el tamaño.
+             */
+            class RxChunkPool
+            {
+            public:
+                /**
+                 * Bloques por defecto de un transporte. Un paquete decodificado retiene su
+                 * bloque mientras espera aguas abajo sin copiarse: en la cola de entrada del
+                 * agregador (ingressDepth = 8 por cliente), más el bloque que se está
+                 * llenando y el del paquete que se procesa. Las colas que pueden retener
+                 * paquetes mucho tiempo (TX congestionada) se quedan una copia propia
+                 * (detachedCopy) en lugar de retener el bloque.
+                 */
+                static constexpr size_t kDefaultChunkCount = 8 + 2;
+
+                RxChunkPool(size_t chunkSize, size_t chunkCount, const char *name = "RxChunkPool")
+                    : chunkSize_(chunkSize),
+                      name_(name),
+                      m_mutex(Core::OSAL::Factory::createMutex(name))
+                {
+                    chunks_.reserve(chunkCount);
+                    for (size_t i = 0; i < chunkCount; ++i)
+                    {
+                        chunks_.push_back(std::make_shared<RxChunk>(chunkSize));
+                    }
+                }
+
+                std::shared_ptr<RxChunk> acquire()
+                {
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*m_mutex);
+                        for (size_t n = 0; n < chunks_.size(); ++n)
+                        {
+                            size_t index = (cursor_ + n) % chunks_.size();
+                            if (chunks_[index].use_count() == 1)
+                            {
+                                // Lo que hizo el último dueño con el bloque ocurre antes que nuestra escritura
+                                std::atomic_thread_fence(std::memory_order_acquire);
+                                cursor_ = index + 1;
+                                chunks_[index]->len = 0;
+                                return chunks_[index];
+                            }
+                        }
+                    }
+
+                    uint32_t overflow = ++overflow_;
+                    if ((overflow & (overflow - 1)) == 0)
+                    {
+                        FP_LOG_W(name_, "Pool agotado (%u bloques de %u bytes): %u bloques sueltos",
+                                 (unsigned)chunks_.size(), (unsigned)chunkSize_, (unsigned)overflow);
+                    }
+                    return std::make_shared<RxChunk>(chunkSize_);
+                }
+
+                size_t chunkSize() const { return chunkSize_; }
+
+                // Veces que no había bloque libre y se reservó uno suelto
+                uint32_t overflowCount() const { return overflow_.load(); }
+
+            private:
+                size_t chunkSize_;
+                const char *name_;
+                std::unique_ptr<Core::OSAL::IMutex> m_mutex;
+                std::vector<std::shared_ptr<RxChunk>> chunks_;
+                size_t cursor_ = 0;
+                std::atomic<uint32_t> overflow_{0};
+            };
+        }
+    }
+}
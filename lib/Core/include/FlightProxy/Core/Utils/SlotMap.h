@@ -0,0 +1,273 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/Utils/Logger.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Registro de capacidad fija con handles etiquetados por generación.
+             *
+             * Un handle es (generación << 16) | índice: la búsqueda es un acceso directo
+             * al índice más la comprobación de la generación, así que un handle de un
+             * elemento ya borrado (o de un hueco reutilizado) se detecta y devuelve null.
+             *
+             * Lecturas RCU sin locks: la tabla es inmutable y se publica con un puntero
+             * atómico. Un lector se apunta en el contador de la época actual (dos
+             * contadores que se alternan), lee el puntero y se borra al terminar: solo
+             * atómicos, ni mutex ni spin. Los escritores (insert/erase, poco frecuentes)
+             * copian la tabla bajo el mutex OSAL, publican la nueva y, tras un periodo de
+             * gracia (cambiar de época dos veces y esperar a que cada contador se vacíe),
+             * liberan las viejas.
+             *
+             * Un escritor que a la vez está leyendo (p. ej. un onClose disparado durante
+             * un recorrido) no puede esperar a los lectores: deja la tabla vieja
+             * retirada y la libera la siguiente escritura. Lo mismo si el periodo de
+             * gracia no termina en kGraceTimeoutMs (un lector que no sale): la escritura
+             * no se bloquea, se avisa en el log y las tablas siguen retiradas.
+             */
+            template <typename T>
+            class SlotMap
+            {
+            public:
+                using Handle = uint32_t;
+                static constexpr Handle kInvalidHandle = 0;
+
+                struct Slot
+                {
+                    uint16_t generation = 0;
+                    std::shared_ptr<T> value;
+                };
+                using Table = std::vector<Slot>;
+
+                /**
+                 * @brief Sección de lectura: mientras exista, la tabla que ve no se libera.
+                 * Debe ser corta; un escritor espera a que termine.
+                 */
+                class Snapshot
+                {
+                public:
+                    Snapshot(Snapshot &&other) noexcept
+                        : map_(other.map_), parity_(other.parity_), table_(other.table_)
+                    {
+                        other.map_ = nullptr;
+                    }
+                    Snapshot(const Snapshot &) = delete;
+                    Snapshot &operator=(const Snapshot &) = delete;
+                    Snapshot &operator=(Snapshot &&) = delete;
+
+                    ~Snapshot()
+                    {
+                        if (map_)
+                            map_->readUnlock(parity_);
+                    }
+
+                    const Table &operator*() const { return *table_; }
+                    const Table *operator->() const { return table_; }
+
+                private:
+                    friend class SlotMap;
+
+                    explicit Snapshot(const SlotMap &map) : map_(&map)
+                    {
+                        table_ = map.readLock(parity_);
+                    }
+
+                    const SlotMap *map_;
+                    unsigned parity_ = 0;
+                    const Table *table_ = nullptr;
+                };
+
+                explicit SlotMap(size_t capacity)
+                    : writeMutex_(Core::OSAL::Factory::createMutex("SlotMap.write"))
+                {
+                    if (capacity == 0)
+                        capacity = 1;
+                    if (capacity > kMaxCapacity)
+                        capacity = kMaxCapacity;
+                    table_.store(new Table(capacity));
+                }
+
+                ~SlotMap()
+                {
+                    // Sin lectores: el dueño ya no comparte el registro
+                    delete table_.load();
+                    for (const Table *retired : retired_)
+                        delete retired;
+                }
+
+                SlotMap(const SlotMap &) = delete;
+                SlotMap &operator=(const SlotMap &) = delete;
+
+                /**
+                 * @brief Inserta un valor en el primer hueco libre.
+                 * @return Handle del elemento, o kInvalidHandle si no queda sitio.
+                 */
+                Handle insert(std::shared_ptr<T> value)
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*writeMutex_);
+
+                    const Table &current = *table_.load();
+                    for (size_t i = 0; i < current.size(); ++i)
+                    {
+                        if (!current[i].value)
+                        {
+                            Table *next = new Table(current);
+                            Slot &slot = (*next)[i];
+                            // La generación 0 nunca se usa: así un handle nunca vale 0
+                            slot.generation = static_cast<uint16_t>(slot.generation + 1);
+                            if (slot.generation == 0)
+                                slot.generation = 1;
+                            slot.value = std::move(value);
+
+                            Handle handle = makeHandle(i, slot.generation);
+                            publish(next);
+                            return handle;
+                        }
+                    }
+                    return kInvalidHandle;
+                }
+
+                /**
+                 * @brief Borra el elemento si el handle sigue siendo válido.
+                 */
+                bool erase(Handle handle)
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*writeMutex_);
+
+                    const Table &current = *table_.load();
+                    size_t index = indexOf(handle);
+                    if (index >= current.size())
+                        return false;
+
+                    const Slot &slot = current[index];
+                    if (!slot.value || slot.generation != generationOf(handle))
+                        return false;
+
+                    Table *next = new Table(current);
+                    (*next)[index].value.reset(); // La generación se conserva para invalidar el handle
+                    publish(next);
+                    return true;
+                }
+
+                /**
+                 * @brief Búsqueda O(1) sin locks. Devuelve null si el handle está caducado.
+                 */
+                std::shared_ptr<T> get(Handle handle) const
+                {
+                    Snapshot current(*this);
+                    size_t index = indexOf(handle);
+                    if (index >= current->size())
+                        return nullptr;
+
+                    const Slot &slot = (*current)[index];
+                    if (slot.generation != generationOf(handle))
+                        return nullptr;
+                    return slot.value;
+                }
+
+                /**
+                 * @brief Vista de la tabla para recorrerla sin bloquear.
+                 */
+                Snapshot snapshot() const
+                {
+                    return Snapshot(*this);
+                }
+
+                static Handle makeHandle(size_t index, uint16_t generation)
+                {
+                    return (static_cast<Handle>(generation) << kIndexBits) | static_cast<Handle>(index);
+                }
+
+                static size_t indexOf(Handle handle) { return handle & kIndexMask; }
+                static uint16_t generationOf(Handle handle) { return static_cast<uint16_t>(handle >> kIndexBits); }
+
+            private:
+                static constexpr unsigned kIndexBits = 16;
+                static constexpr Handle kIndexMask = (1u << kIndexBits) - 1;
+                static constexpr size_t kMaxCapacity = kIndexMask + 1;
+                static constexpr uint32_t kGraceTimeoutMs = 1000;
+
+                // Secciones de lectura abiertas por este hilo (en cualquier SlotMap)
+                static uint32_t &readDepth()
+                {
+                    static thread_local uint32_t depth = 0;
+                    return depth;
+                }
+
+                // El orden apuntarse -> leer el puntero frente a publicar -> esperar
+                // contador (seq_cst en los dos lados) garantiza que quien vio la
+                // tabla vieja está contado cuando el escritor mira
+                const Table *readLock(unsigned &parity) const
+                {
+                    parity = epoch_.load() & 1u;
+                    readers_[parity].fetch_add(1);
+                    readDepth()++;
+                    return table_.load();
+                }
+
+                void readUnlock(unsigned parity) const
+                {
+                    readDepth()--;
+                    readers_[parity].fetch_sub(1);
+                }
+
+                // Espera a que el contador se vacíe; false si no lo hace en kGraceTimeoutMs
+                bool waitReaders(unsigned parity) const
+                {
+                    for (uint32_t waited = 0; readers_[parity].load() != 0; ++waited)
+                    {
+                        if (waited >= kGraceTimeoutMs)
+                            return false;
+                        Core::OSAL::Factory::sleep(1);
+                    }
+                    return true;
+                }
+
+                // Con writeMutex_ tomado
+                void publish(Table *next)
+                {
+                    retired_.push_back(table_.exchange(next));
+
+                    if (readDepth() != 0)
+                        return; // Esperarnos a nosotros mismos sería un bloqueo: la libera otra escritura
+
+                    // Periodo de gracia: cada cambio de época deja de apuntar lectores nuevos
+                    // en el contador viejo, que solo puede bajar. Tras vaciar los dos, ningún
+                    // lector puede tener una tabla retirada.
+                    for (int flip = 0; flip < 2; ++flip)
+                    {
+                        unsigned old = epoch_.fetch_add(1) & 1u;
+                        if (!waitReaders(old))
+                        {
+                            FP_LOG_W("SlotMap", "Lectores sin salir tras %u ms: %u tablas retiradas sin liberar",
+                                     (unsigned)kGraceTimeoutMs, (unsigned)retired_.size());
+                            return;
+                        }
+                    }
+
+                    for (const Table *retired : retired_)
+                        delete retired;
+                    retired_.clear();
+                }
+
+                std::unique_ptr<Core::OSAL::IMutex> writeMutex_;
+                std::atomic<const Table *> table_{nullptr};
+                std::atomic<uint32_t> epoch_{0};
+                mutable std::atomic<uint32_t> readers_[2] = {};
+                std::vector<const Table *> retired_; // Solo con writeMutex_
+            };
+
+        } // namespace Utils
+    } // namespace Core
+} // namespace FlightProxy
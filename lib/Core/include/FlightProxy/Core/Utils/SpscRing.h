@@ -0,0 +1,270 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/OSALFactory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Anillo lock-free de un productor y un consumidor (wait-free).
+             *
+             * Cada lado escribe solo su índice (release) y lee el del otro (acquire),
+             * así que no hay CAS ni bucles de reintento. Eso basta en el Xtensa de doble
+             * núcleo (GCC emite memw) y en x86/ARM. Cada lado guarda además una copia del
+             * índice del otro y solo lo vuelve a leer cuando parece que la cola está
+             * llena o vacía: casi nunca se comparte la línea de caché.
+             *
+             * Solo una tarea puede llamar a push* y solo una a pop*.
+             * La capacidad se redondea a la siguiente potencia de dos.
+             * T debe ser construible por defecto y asignable por movimiento.
+             */
+            template <typename T>
+            class SpscRing
+            {
+            public:
+                explicit SpscRing(size_t capacity)
+                    : mask_(roundUpPow2(capacity < 2 ? 2 : capacity) - 1),
+                      buffer_(new T[mask_ + 1])
+                {
+                }
+
+                SpscRing(const SpscRing &) = delete;
+                SpscRing &operator=(const SpscRing &) = delete;
+
+                // --- Lado productor ---
+
+                /**
+                 * @brief Intenta encolar sin bloquear.
+                 * @return false si está lleno (el ítem no se consume).
+                 */
+                bool tryPush(T &&item) { return emplace(std::move(item)); }
+                bool tryPush(const T &item) { return emplace(item); }
+
+                /**
+                 * @brief Mueve al anillo todos los ítems que quepan de 'items'.
+                 * @return Número de ítems encolados (los primeros); el resto no se toca.
+                 */
+                size_t pushN(T *items, size_t count)
+                {
+                    size_t head = head_.load(std::memory_order_relaxed);
+                    size_t free = freeSlots(head, count);
+                    size_t n = count < free ? count : free;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        buffer_[(head + i) & mask_] = std::move(items[i]);
+                    }
+                    if (n > 0)
+                        head_.store(head + n, std::memory_order_release);
+                    return n;
+                }
+
+                // --- Lado consumidor ---
+
+                /**
+                 * @brief Intenta desencolar sin bloquear.
+                 * @return false si está vacío.
+                 */
+                bool tryPop(T &item)
+                {
+                    return popN(&item, 1) == 1;
+                }
+
+                /**
+                 * @brief Saca hasta 'maxItems' ítems de una vez.
+                 * @return Número de ítems movidos a 'items'.
+                 */
+                size_t popN(T *items, size_t maxItems)
+                {
+                    size_t tail = tail_.load(std::memory_order_relaxed);
+                    size_t available = usedSlots(tail, maxItems);
+                    size_t n = maxItems < available ? maxItems : available;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        // La celda queda "movida" (p. ej. unique_ptr nulo): no retiene nada
+                        items[i] = std::move(buffer_[(tail + i) & mask_]);
+                    }
+                    if (n > 0)
+                        tail_.store(tail + n, std::memory_order_release);
+                    return n;
+                }
+
+                size_t capacity() const { return mask_ + 1; }
+
+                /**
+                 * @brief Número aproximado de ítems (exacto desde el productor o el consumidor).
+                 */
+                size_t sizeApprox() const
+                {
+                    // tail_ primero: head_ leído después nunca es menor
+                    size_t tail = tail_.load(std::memory_order_acquire);
+                    size_t head = head_.load(std::memory_order_acquire);
+                    return head - tail;
+                }
+
+                bool emptyApprox() const { return sizeApprox() == 0; }
+
+            private:
+                static constexpr size_t kCacheLine = 64;
+
+                template <typename U>
+                bool emplace(U &&item)
+                {
+                    size_t head = head_.load(std::memory_order_relaxed);
+                    if (freeSlots(head, 1) == 0)
+                        return false; // Lleno
+                    buffer_[head & mask_] = std::forward<U>(item);
+                    head_.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+
+                // Huecos libres vistos por el productor; relee tail_ solo si la copia no basta
+                size_t freeSlots(size_t head, size_t wanted)
+                {
+                    size_t free = capacity() - (head - cachedTail_);
+                    if (free < wanted)
+                    {
+                        cachedTail_ = tail_.load(std::memory_order_acquire);
+                        free = capacity() - (head - cachedTail_);
+                    }
+                    return free;
+                }
+
+                // Ítems disponibles vistos por el consumidor; relee head_ solo si la copia no basta
+                size_t usedSlots(size_t tail, size_t wanted)
+                {
+                    size_t used = cachedHead_ - tail;
+                    if (used < wanted)
+                    {
+                        cachedHead_ = head_.load(std::memory_order_acquire);
+                        used = cachedHead_ - tail;
+                    }
+                    return used;
+                }
+
+                static size_t roundUpPow2(size_t v)
+                {
+                    size_t p = 1;
+                    while (p < v)
+                        p <<= 1;
+                    return p;
+                }
+
+                const size_t mask_;
+                std::unique_ptr<T[]> buffer_;
+
+                // Lado productor y lado consumidor en líneas de caché distintas
+                alignas(kCacheLine) std::atomic<size_t> head_{0};
+                size_t cachedTail_ = 0;
+                alignas(kCacheLine) std::atomic<size_t> tail_{0};
+                size_t cachedHead_ = 0;
+            };
+
+            /**
+             * @brief SpscRing con espera opcional: el consumidor duerme en una flag de
+             * eventos del OSAL cuando está vacío y el productor en otra cuando está lleno.
+             *
+             * Los datos siguen viajando por el anillo; las flags solo despiertan. Una flag
+             * que ya está activa no se pierde, así que no hay despertares perdidos entre
+             * comprobar el anillo y dormir.
+             */
+            template <typename T>
+            class BlockingSpscRing
+            {
+            public:
+                explicit BlockingSpscRing(size_t capacity)
+                    : ring_(capacity),
+                      events_(Core::OSAL::Factory::createEventFlags())
+                {
+                }
+
+                // --- Lado productor ---
+
+                bool tryPush(T &&item) { return afterPush(ring_.tryPush(std::move(item)) ? 1 : 0) > 0; }
+                size_t tryPushN(T *items, size_t count) { return afterPush(ring_.pushN(items, count)); }
+
+                /**
+                 * @brief Encola esperando hasta timeout_ms a que haya sitio.
+                 * @return false si hubo timeout (el ítem no se consume).
+                 */
+                bool push(T &&item, uint32_t timeout_ms)
+                {
+                    uint64_t deadline = Core::OSAL::Factory::getSystemTimeMs() + timeout_ms;
+                    while (!ring_.tryPush(std::move(item)))
+                    {
+                        if (!wait(kNotFull, deadline))
+                            return false;
+                    }
+                    afterPush(1);
+                    return true;
+                }
+
+                // --- Lado consumidor ---
+
+                bool tryPop(T &item) { return afterPop(ring_.tryPop(item) ? 1 : 0) > 0; }
+                size_t tryPopN(T *items, size_t maxItems) { return afterPop(ring_.popN(items, maxItems)); }
+
+                /**
+                 * @brief Espera hasta timeout_ms a que haya algo y saca todo lo que haya
+                 * (hasta maxItems) con un solo despertar.
+                 * @return Número de ítems recibidos (0 si hubo timeout).
+                 */
+                size_t popN(T *items, size_t maxItems, uint32_t timeout_ms)
+                {
+                    uint64_t deadline = Core::OSAL::Factory::getSystemTimeMs() + timeout_ms;
+                    size_t n;
+                    while ((n = ring_.popN(items, maxItems)) == 0)
+                    {
+                        if (!wait(kNotEmpty, deadline))
+                            return 0;
+                    }
+                    return afterPop(n);
+                }
+
+                bool pop(T &item, uint32_t timeout_ms) { return popN(&item, 1, timeout_ms) == 1; }
+
+                size_t capacity() const { return ring_.capacity(); }
+                size_t sizeApprox() const { return ring_.sizeApprox(); }
+                bool emptyApprox() const { return ring_.emptyApprox(); }
+
+            private:
+                SpscRing<T> ring_;
+                static constexpr Core::OSAL::IEventFlags::Bits kNotEmpty = 1u << 0;
+                static constexpr Core::OSAL::IEventFlags::Bits kNotFull = 1u << 1;
+                std::unique_ptr<Core::OSAL::IEventFlags> events_;
+
+                size_t afterPush(size_t n)
+                {
+                    if (n > 0)
+                        events_->set(kNotEmpty);
+                    return n;
+                }
+
+                size_t afterPop(size_t n)
+                {
+                    if (n > 0)
+                        events_->set(kNotFull);
+                    return n;
+                }
+
+                // Duerme en la flag hasta el deadline; false si ya venció
+                bool wait(Core::OSAL::IEventFlags::Bits flag, uint64_t deadline)
+                {
+                    uint64_t now = Core::OSAL::Factory::getSystemTimeMs();
+                    if (now >= deadline)
+                        return false;
+                    events_->waitAny(flag, static_cast<uint32_t>(deadline - now));
+                    return true;
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,423 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace FlightProxy
+{
+    namespace Core
+    {
+        namespace Utils
+        {
+            /**
+             * @brief Rueda de temporización jerárquica (estilo Varghese/Linux).
+             *
+             * 4 niveles de 64 casillas: el nivel 0 tiene resolución de un tick y cada
+             * nivel superior cubre 64 veces más. Un temporizador entra en la casilla de
+             * su deadline en el nivel más bajo que lo alcanza y, al llegar el tiempo de
+             * esa casilla, baja ("cascada") al nivel inferior hasta vencer en el nivel 0.
+             * Insertar y cancelar son O(1) (listas intrusivas sobre bloques de nodos); con
+             * un bitmap de casillas ocupadas por nivel, saber cuándo hay que despertar
+             * también es O(1).
+             *
+             * Los nodos se reservan por bloques del tamaño inicial: si se llenan se añade
+             * otro (hasta kMaxTimers) en lugar de rechazar el temporizador. Los bloques no
+             * se mueven, así que el callback que devuelve popExpired() sigue siendo válido
+             * aunque la rueda crezca mientras se ejecuta.
+             *
+             * Los deadlines van en microsegundos absolutos; la precisión real es el tick.
+             * Un temporizador nunca vence antes de su deadline.
+             *
+             * No es thread-safe: la protege quien la usa (ver OSAL::TimerService).
+             */
+            class TimerWheel
+            {
+            public:
+                using TimerId = uint32_t; // (generación << 16) | (índice + 1); 0 = inválido
+                using Callback = std::function<void()>;
+
+                static constexpr TimerId kInvalidTimer = 0;
+                static constexpr size_t kMaxTimers = 0xFFFF;
+
+                // 'capacity' = nodos del primer bloque (se redondea a potencia de 2)
+                TimerWheel(uint32_t tickUs, size_t capacity, uint64_t nowUs)
+                    : tickUs_(tickUs > 0 ? tickUs : 1)
+                {
+                    while (blockBits_ < kMaxBlockBits && (size_t(1) << blockBits_) < capacity)
+                        blockBits_++;
+
+                    currentTick_ = nowUs / tickUs_;
+                    for (auto &level : slots_)
+                    {
+                        for (auto &head : level)
+                            head = kNil;
+                    }
+                    grow();
+                }
+
+                /**
+                 * @brief Programa un temporizador.
+                 * @param deadlineUs Instante absoluto del primer vencimiento.
+                 * @param periodUs 0 para uno solo; si no, se rearma cada periodUs.
+                 * @return Id del temporizador, o kInvalidTimer si ya hay kMaxTimers.
+                 */
+                TimerId schedule(uint64_t deadlineUs, uint64_t periodUs, Callback callback)
+                {
+                    if (freeHead_ == kNil && !grow())
+                        return kInvalidTimer;
+
+                    uint32_t index = freeHead_;
+                    Node &node = nodeAt(index);
+                    freeHead_ = node.next;
+
+                    node.generation = static_cast<uint16_t>(node.generation + 1);
+                    if (node.generation == 0)
+                        node.generation = 1;
+                    node.callback = std::move(callback);
+                    node.deadlineUs = deadlineUs;
+                    node.deadlineTick = toTick(deadlineUs);
+                    node.periodUs = periodUs;
+                    node.cancelled = false;
+                    active_++;
+
+                    place(index);
+                    return makeId(index, node.generation);
+                }
+
+                /**
+                 * @brief Cancela un temporizador. Si su callback se está ejecutando en ese
+                 * momento, termina pero ya no se rearma.
+                 * @return false si el id ya no es válido (vencido o cancelado antes).
+                 */
+                bool cancel(TimerId id)
+                {
+                    uint32_t index;
+                    if (!resolve(id, index))
+                        return false;
+
+                    Node &node = nodeAt(index);
+                    if (node.where == kRunning)
+                    {
+                        node.cancelled = true;
+                        return true;
+                    }
+                    unlink(index);
+                    release(index);
+                    return true;
+                }
+
+                /**
+                 * @brief Avanza la rueda hasta nowUs y pasa a la lista de vencidos todo lo
+                 * que haya llegado a su deadline. Salta los ticks en los que no pasa nada.
+                 */
+                void advance(uint64_t nowUs)
+                {
+                    uint64_t nowTick = nowUs / tickUs_;
+                    while (currentTick_ < nowTick)
+                    {
+                        uint64_t next = nextEventTick();
+                        if (next > nowTick)
+                        {
+                            currentTick_ = nowTick;
+                            break;
+                        }
+                        currentTick_ = next;
+                        step();
+                    }
+                }
+
+                /**
+                 * @brief Saca el siguiente temporizador vencido para ejecutar su callback.
+                 * Después hay que llamar a finish() con el mismo id.
+                 * @return kInvalidTimer si no queda ninguno.
+                 */
+                TimerId popExpired(Callback *&callback)
+                {
+                    if (dueHead_ == kNil)
+                        return kInvalidTimer;
+
+                    uint32_t index = dueHead_;
+                    unlink(index);
+                    Node &node = nodeAt(index);
+                    node.where = kRunning;
+                    callback = &node.callback;
+                    return makeId(index, node.generation);
+                }
+
+                /**
+                 * @brief Cierra la ejecución de un temporizador vencido: los periódicos se
+                 * rearman (sin acumular vencimientos perdidos) y el resto se liberan.
+                 *
+                 * El periodo se suma al vencimiento absoluto en µs y solo ese se redondea a
+                 * tick: sumar periodos ya redondeados haría que 1500 µs saltase cada 2 ms.
+                 */
+                void finish(TimerId id, uint64_t nowUs)
+                {
+                    uint32_t index;
+                    if (!resolve(id, index) || nodeAt(index).where != kRunning)
+                        return;
+
+                    Node &node = nodeAt(index);
+                    if (node.periodUs == 0 || node.cancelled)
+                    {
+                        release(index);
+                        return;
+                    }
+
+                    // Por debajo de un tick la rueda no distingue: como mucho uno por tick
+                    uint64_t periodUs = node.periodUs < tickUs_ ? tickUs_ : node.periodUs;
+                    node.deadlineUs += periodUs;
+                    if (node.deadlineUs < nowUs)
+                    {
+                        // Con retraso: salta los periodos perdidos (sale una vez, ya) sin perder la fase
+                        node.deadlineUs += (nowUs - node.deadlineUs) / periodUs * periodUs;
+                    }
+                    node.deadlineTick = toTick(node.deadlineUs);
+                    place(index);
+                }
+
+                /**
+                 * @brief Instante (µs) en el que habrá algo que hacer: un vencimiento o una
+                 * cascada (ya pasado si hay vencidos sin sacar). UINT64_MAX si no hay
+                 * temporizadores.
+                 */
+                uint64_t nextWakeUs() const
+                {
+                    uint64_t tick = (dueHead_ != kNil) ? currentTick_ : nextEventTick();
+                    return tick == UINT64_MAX ? UINT64_MAX : tick * tickUs_;
+                }
+
+                bool hasExpired() const { return dueHead_ != kNil; }
+                size_t activeCount() const { return active_; }
+                size_t capacity() const { return capacity_; }
+                uint32_t tickUs() const { return tickUs_; }
+
+            private:
+                static constexpr size_t kLevels = 4;
+                static constexpr unsigned kSlotBits = 6;
+                static constexpr size_t kSlots = size_t(1) << kSlotBits;
+                static constexpr uint64_t kSlotMask = kSlots - 1;
+                static constexpr uint32_t kNil = 0xFFFFFFFF;
+                static constexpr unsigned kMaxBlockBits = 12; // Bloques de hasta 4096 nodos
+
+                // Dónde está el nodo
+                static constexpr uint8_t kFree = 0;
+                static constexpr uint8_t kWheel = 1;
+                static constexpr uint8_t kDue = 2;
+                static constexpr uint8_t kRunning = 3;
+
+                struct Node
+                {
+                    Callback callback;
+                    uint64_t deadlineUs = 0; // Vencimiento exacto; deadlineTick es su redondeo
+                    uint64_t deadlineTick = 0;
+                    uint64_t periodUs = 0;
+                    uint32_t prev = kNil;
+                    uint32_t next = kNil;
+                    uint16_t generation = 0;
+                    uint8_t where = kFree;
+                    uint8_t level = 0;
+                    uint8_t slot = 0;
+                    bool cancelled = false;
+                };
+
+                uint32_t tickUs_;
+                unsigned blockBits_ = 0;
+                std::vector<std::unique_ptr<Node[]>> blocks_; // Todos de 1 << blockBits_ nodos
+                size_t capacity_ = 0;
+                uint32_t slots_[kLevels][kSlots];
+                uint64_t occupied_[kLevels] = {};
+                uint32_t dueHead_ = kNil;
+                uint32_t dueTail_ = kNil;
+                uint32_t freeHead_ = kNil;
+                uint64_t currentTick_ = 0;
+                size_t active_ = 0;
+
+                Node &nodeAt(size_t index) { return blocks_[index >> blockBits_][index & ((size_t(1) << blockBits_) - 1)]; }
+                const Node &nodeAt(size_t index) const { return blocks_[index >> blockBits_][index & ((size_t(1) << blockBits_) - 1)]; }
+
+                // Añade un bloque de nodos libres. false si se pasaría de kMaxTimers
+                bool grow()
+                {
+                    size_t blockSize = size_t(1) << blockBits_;
+                    if (capacity_ + blockSize > kMaxTimers)
+                        return false;
+
+                    blocks_.emplace_back(new Node[blockSize]);
+                    for (size_t i = capacity_; i < capacity_ + blockSize; ++i)
+                    {
+                        nodeAt(i).next = (i + 1 < capacity_ + blockSize) ? static_cast<uint32_t>(i + 1) : freeHead_;
+                    }
+                    freeHead_ = static_cast<uint32_t>(capacity_);
+                    capacity_ += blockSize;
+                    return true;
+                }
+
+                // Redondeo hacia arriba: nunca antes del deadline
+                uint64_t toTick(uint64_t us) const { return (us + tickUs_ - 1) / tickUs_; }
+
+                static TimerId makeId(uint32_t index, uint16_t generation)
+                {
+                    return (static_cast<TimerId>(generation) << 16) | (index + 1);
+                }
+
+                bool resolve(TimerId id, uint32_t &index) const
+                {
+                    uint32_t low = id & 0xFFFF;
+                    if (low == 0 || low > capacity_)
+                        return false;
+                    index = low - 1;
+                    const Node &node = nodeAt(index);
+                    return node.where != kFree && node.generation == (id >> 16);
+                }
+
+                static unsigned lowestBit(uint64_t bits) { return static_cast<unsigned>(__builtin_ctzll(bits)); }
+
+                static uint64_t rotateRight(uint64_t bits, unsigned n)
+                {
+                    n &= 63;
+                    return n == 0 ? bits : ((bits >> n) | (bits << (64 - n)));
+                }
+
+                // Coloca el nodo en su casilla (o en vencidos si su tick ya pasó)
+                void place(uint32_t index)
+                {
+                    Node &node = nodeAt(index);
+                    if (node.deadlineTick <= currentTick_)
+                    {
+                        appendDue(index);
+                        return;
+                    }
+
+                    uint64_t delta = node.deadlineTick - currentTick_;
+                    uint64_t target = node.deadlineTick;
+                    size_t level = 0;
+                    while (level < kLevels - 1 && delta >= (uint64_t(1) << (kSlotBits * (level + 1))))
+                        level++;
+
+                    // Más lejos de lo que cubre la rueda: a la última casilla; al bajar se recoloca
+                    uint64_t span = uint64_t(1) << (kSlotBits * kLevels);
+                    if (delta >= span)
+                        target = currentTick_ + span - 1;
+
+                    size_t slot = (target >> (kSlotBits * level)) & kSlotMask;
+                    node.where = kWheel;
+                    node.level = static_cast<uint8_t>(level);
+                    node.slot = static_cast<uint8_t>(slot);
+                    node.prev = kNil;
+                    node.next = slots_[level][slot];
+                    if (node.next != kNil)
+                        nodeAt(node.next).prev = index;
+                    slots_[level][slot] = index;
+                    occupied_[level] |= uint64_t(1) << slot;
+                }
+
+                void appendDue(uint32_t index)
+                {
+                    Node &node = nodeAt(index);
+                    node.where = kDue;
+                    node.next = kNil;
+                    node.prev = dueTail_;
+                    if (dueTail_ != kNil)
+                        nodeAt(dueTail_).next = index;
+                    else
+                        dueHead_ = index;
+                    dueTail_ = index;
+                }
+
+                void unlink(uint32_t index)
+                {
+                    Node &node = nodeAt(index);
+                    if (node.where == kWheel)
+                    {
+                        uint32_t &head = slots_[node.level][node.slot];
+                        if (node.prev != kNil)
+                            nodeAt(node.prev).next = node.next;
+                        else
+                            head = node.next;
+                        if (node.next != kNil)
+                            nodeAt(node.next).prev = node.prev;
+                        if (head == kNil)
+                            occupied_[node.level] &= ~(uint64_t(1) << node.slot);
+                    }
+                    else if (node.where == kDue)
+                    {
+                        if (node.prev != kNil)
+                            nodeAt(node.prev).next = node.next;
+                        else
+                            dueHead_ = node.next;
+                        if (node.next != kNil)
+                            nodeAt(node.next).prev = node.prev;
+                        else
+                            dueTail_ = node.prev;
+                    }
+                    node.prev = node.next = kNil;
+                }
+
+                void release(uint32_t index)
+                {
+                    Node &node = nodeAt(index);
+                    node.callback = nullptr;
+                    node.where = kFree;
+                    node.next = freeHead_;
+                    freeHead_ = index;
+                    active_--;
+                }
+
+                // Primer tick futuro con un vencimiento en el nivel 0 o una cascada pendiente
+                uint64_t nextEventTick() const
+                {
+                    uint64_t best = UINT64_MAX;
+                    for (size_t level = 0; level < kLevels; ++level)
+                    {
+                        if (!occupied_[level])
+                            continue;
+                        unsigned shift = kSlotBits * level;
+                        uint64_t nextBlock = (currentTick_ >> shift) + 1;
+                        uint64_t offset = lowestBit(rotateRight(occupied_[level], static_cast<unsigned>(nextBlock & kSlotMask)));
+                        uint64_t tick = (nextBlock + offset) << shift;
+                        if (tick < best)
+                            best = tick;
+                    }
+                    return best;
+                }
+
+                // Procesa currentTick_: cascadas de arriba abajo y vencimientos del nivel 0
+                void step()
+                {
+                    for (size_t level = kLevels - 1; level > 0; --level)
+                    {
+                        unsigned shift = kSlotBits * level;
+                        if (currentTick_ & ((uint64_t(1) << shift) - 1))
+                            continue; // No es frontera de este nivel
+                        size_t slot = (currentTick_ >> shift) & kSlotMask;
+                        uint32_t index = slots_[level][slot];
+                        slots_[level][slot] = kNil;
+                        occupied_[level] &= ~(uint64_t(1) << slot);
+                        while (index != kNil)
+                        {
+                            uint32_t next = nodeAt(index).next;
+                            place(index);
+                            index = next;
+                        }
+                    }
+
+                    size_t slot = currentTick_ & kSlotMask;
+                    uint32_t index = slots_[0][slot];
+                    slots_[0][slot] = kNil;
+                    occupied_[0] &= ~(uint64_t(1) << slot);
+                    while (index != kNil)
+                    {
+                        uint32_t next = nodeAt(index).next;
+                        appendDue(index);
+                        index = next;
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "FlightProxy/Core/OSAL/IEventFlags.h"
+#include "FlightProxy/Core/OSAL/TaskRegistry.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+
+#include <atomic>
+
+namespace FlightProxy
+{
+    namespace PlatformESP32
+    {
+        namespace OSAL
+        {
+            // Event group de FreeRTOS: set/wait sin copiar ítems ni reservar memoria
+            class FreeRTOSEventFlags : public Core::OSAL::IEventFlags
+            {
+            public:
+                FreeRTOSEventFlags() { groupHandle_ = xEventGroupCreate(); }
+                virtual ~FreeRTOSEventFlags() { vEventGroupDelete(groupHandle_); }
+
+                void set(Bits bits) override
+                {
+                    setAtUs_.store(nowUs(), std::memory_order_relaxed);
+                    xEventGroupSetBits(groupHandle_, bits & kUsableBits);
+                }
+
+                void clear(Bits bits) override { xEventGroupClearBits(groupHandle_, bits & kUsableBits); }
+                Bits get() const override { return xEventGroupGetBits(groupHandle_); }
+
+                Bits wait(Bits bits, bool waitAll, bool clearOnExit, uint32_t timeout_ms) override
+                {
+                    // Un timeout distinto de 0 espera al menos un tick
+                    TickType_t ticksToWait = pdMS_TO_TICKS(timeout_ms);
+                    if (timeout_ms > 0 && ticksToWait == 0)
+                        ticksToWait = 1;
+
+                    uint32_t enteredUs = nowUs();
+                    Bits result = xEventGroupWaitBits(groupHandle_, bits & kUsableBits,
+                                                      clearOnExit ? pdTRUE : pdFALSE,
+                                                      waitAll ? pdTRUE : pdFALSE,
+                                                      ticksToWait);
+
+                    // Si el set() llegó mientras esperábamos, hubo despertar: anotamos su latencia
+                    bool satisfied = waitAll ? (result & bits) == bits : (result & bits) != 0;
+                    uint32_t setAtUs = setAtUs_.load(std::memory_order_relaxed);
+                    if (satisfied && static_cast<int32_t>(setAtUs - enteredUs) >= 0)
+                    {
+                        Core::OSAL::TaskRegistry::noteWake(nowUs() - setAtUs);
+                    }
+                    return result;
+                }
+
+            private:
+                // Los 8 bits altos los usa el propio kernel
+                static constexpr Bits kUsableBits = 0x00FFFFFF;
+
+                // 32 bits de esp_timer: las restas siguen valiendo al dar la vuelta
+                static uint32_t nowUs() { return static_cast<uint32_t>(esp_timer_get_time()); }
+
+                EventGroupHandle_t groupHandle_;
+                std::atomic<uint32_t> setAtUs_{0}; // Último set()
+            };
+        }
+    }
+}
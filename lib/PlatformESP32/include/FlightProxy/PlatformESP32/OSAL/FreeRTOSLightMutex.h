@@ -0,0 +1,38 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+namespace FlightProxy
+{
+    namespace PlatformESP32
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Mutex no recursivo sin vtable ni heap (semáforo estático).
+             *
+             * Mantiene la herencia de prioridad de los mutex de FreeRTOS, pero se ahorra
+             * la contabilidad del recursivo y la llamada virtual de IMutex. Se usa por
+             * tipo concreto (Core::OSAL::Mutex) con std::lock_guard.
+             */
+            class FreeRTOSLightMutex
+            {
+            public:
+                FreeRTOSLightMutex() { handle_ = xSemaphoreCreateMutexStatic(&buffer_); }
+                ~FreeRTOSLightMutex() { vSemaphoreDelete(handle_); }
+
+                FreeRTOSLightMutex(const FreeRTOSLightMutex &) = delete;
+                FreeRTOSLightMutex &operator=(const FreeRTOSLightMutex &) = delete;
+
+                void lock() { xSemaphoreTake(handle_, portMAX_DELAY); }
+                void unlock() { xSemaphoreGive(handle_); }
+                bool try_lock() { return xSemaphoreTake(handle_, 0) == pdTRUE; }
+
+            private:
+                StaticSemaphore_t buffer_;
+                SemaphoreHandle_t handle_;
+            };
+        }
+    }
+}
@@ -7,6 +7,11 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace FlightProxy
 {
     namespace PlatformESP32
@@ -14,6 +19,12 @@ namespace FlightProxy
         namespace OSAL
         {
             // 3. Declaramos la clase que IMPLEMENTA la interfaz
+            //
+            // La cola de FreeRTOS copia sizeof(T) bytes con memcpy, que solo vale para
+            // tipos trivialmente copiables. Para el resto (unique_ptr, vectores...) el
+            // ítem se mueve a una ranura propia y por la cola de FreeRTOS solo viaja el
+            // índice de la ranura. Las ranuras libres están en otra cola, que es la que
+            // bloquea al emisor cuando no hay sitio.
             template <typename T>
             class FreeRTOSQueue : public Core::OSAL::IQueue<T>
             {
@@ -24,7 +35,23 @@ namespace FlightProxy
                  */
                 FreeRTOSQueue(uint32_t queueLength)
                 {
-                    queueHandle_ = xQueueCreate(queueLength, sizeof(T));
+                    if (kByValue)
+                    {
+                        queueHandle_ = xQueueCreate(queueLength, sizeof(T));
+                    }
+                    else
+                    {
+                        queueHandle_ = xQueueCreate(queueLength, sizeof(SlotIndex));
+                        freeSlots_ = xQueueCreate(queueLength, sizeof(SlotIndex));
+                        slots_.reset(new (std::nothrow) Slot[queueLength]);
+                        if (freeSlots_ && slots_)
+                        {
+                            for (SlotIndex i = 0; i < queueLength; ++i)
+                            {
+                                xQueueSend(freeSlots_, &i, 0);
+                            }
+                        }
+                    }
 
                     // Aquí deberías añadir manejo de error (ej. ESP_ERROR_CHECK)
                     // si queueHandle_ es NULL (no hay memoria).
@@ -32,33 +59,93 @@ namespace FlightProxy
 
                 virtual ~FreeRTOSQueue()
                 {
+                    if (!kByValue && slots_)
+                    {
+                        // Destruimos los ítems que quedaron en la cola
+                        SlotIndex index;
+                        while (queueHandle_ && xQueueReceive(queueHandle_, &index, 0) == pdTRUE)
+                        {
+                            slots_[index].item()->~T();
+                        }
+                    }
+                    if (freeSlots_)
+                        vQueueDelete(freeSlots_);
                     vQueueDelete(queueHandle_);
                 }
 
                 // --- Implementación de la interfaz IQueue ---
 
-                bool send(const T &item, uint32_t timeout_ms) override
+                using Core::OSAL::IQueue<T>::send;
+
+                bool send(T &&item, uint32_t timeout_ms) override
                 {
-                    const TickType_t ticksToWait = pdMS_TO_TICKS(timeout_ms);
+                    const TickType_t ticksToWait = toTicks(timeout_ms);
+
+                    if (kByValue)
+                    {
+                        // Usamos &item para pasar la dirección del ítem a la cola
+                        BaseType_t result = xQueueSend(queueHandle_, &item, ticksToWait);
+
+                        return (result == pdTRUE);
+                    }
 
-                    // Usamos &item para pasar la dirección del ítem a la cola
-                    BaseType_t result = xQueueSend(queueHandle_, &item, ticksToWait);
+                    // Esperamos a una ranura libre; con ella la cola de índices siempre tiene sitio
+                    SlotIndex index;
+                    if (!slots_ || xQueueReceive(freeSlots_, &index, ticksToWait) != pdTRUE)
+                        return false;
 
-                    return (result == pdTRUE);
+                    new (slots_[index].storage) T(std::move(item));
+                    xQueueSend(queueHandle_, &index, 0);
+                    return true;
                 }
 
                 bool receive(T &item, uint32_t timeout_ms) override
                 {
-                    const TickType_t ticksToWait = pdMS_TO_TICKS(timeout_ms);
+                    const TickType_t ticksToWait = toTicks(timeout_ms);
 
-                    // Usamos &item para pasar la dirección donde se copiará el ítem
-                    BaseType_t result = xQueueReceive(queueHandle_, &item, ticksToWait);
+                    if (kByValue)
+                    {
+                        // Usamos &item para pasar la dirección donde se copiará el ítem
+                        BaseType_t result = xQueueReceive(queueHandle_, &item, ticksToWait);
 
-                    return (result == pdTRUE);
+                        return (result == pdTRUE);
+                    }
+
+                    SlotIndex index;
+                    if (xQueueReceive(queueHandle_, &index, ticksToWait) != pdTRUE)
+                        return false;
+
+                    T *stored = slots_[index].item();
+                    item = std::move(*stored);
+                    stored->~T();
+                    xQueueSend(freeSlots_, &index, 0);
+                    return true;
                 }
 
             private:
-                QueueHandle_t queueHandle_;
+                using SlotIndex = uint32_t;
+
+                // Un timeout distinto de 0 espera al menos un tick (pdMS_TO_TICKS(1) es 0 a 100 Hz)
+                static TickType_t toTicks(uint32_t timeout_ms)
+                {
+                    TickType_t ticks = pdMS_TO_TICKS(timeout_ms);
+                    return (timeout_ms > 0 && ticks == 0) ? 1 : ticks;
+                }
+
+                static constexpr bool kByValue = std::is_trivially_copyable<T>::value;
+
+                struct Slot
+                {
+                    alignas(T) unsigned char storage[sizeof(T)];
+
+                    T *item() { return std::launder(reinterpret_cast<T *>(storage)); }
+                };
+
+                QueueHandle_t queueHandle_ = nullptr;
+
+                // Solo para tipos no trivialmente copiables
+                QueueHandle_t freeSlots_ = nullptr;
+                std::unique_ptr<Slot[]> slots_;
             };
         }
     } // namespace PlatformESP32
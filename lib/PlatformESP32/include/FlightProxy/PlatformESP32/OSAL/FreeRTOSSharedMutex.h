@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FreeRTOSLightMutex.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include <atomic>
+
+namespace FlightProxy
+{
+    namespace PlatformESP32
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Lock de lectores/escritor para tablas que casi solo se leen.
+             *
+             * Los lectores pasan por gate_ solo un instante para apuntarse; el escritor
+             * se queda con gate_ (así no entran lectores nuevos) y espera a que salgan
+             * los que ya estaban. Prioriza al escritor. No es recursivo.
+             * Interfaz de std::shared_mutex (lock/lock_shared...).
+             */
+            class FreeRTOSSharedMutex
+            {
+            public:
+                FreeRTOSSharedMutex() { noReaders_ = xSemaphoreCreateBinaryStatic(&noReadersBuffer_); }
+                ~FreeRTOSSharedMutex() { vSemaphoreDelete(noReaders_); }
+
+                FreeRTOSSharedMutex(const FreeRTOSSharedMutex &) = delete;
+                FreeRTOSSharedMutex &operator=(const FreeRTOSSharedMutex &) = delete;
+
+                // --- Escritor ---
+
+                void lock()
+                {
+                    gate_.lock();
+                    // Un aviso antiguo solo provoca una vuelta más del bucle
+                    while (readers_.load(std::memory_order_acquire) > 0)
+                    {
+                        xSemaphoreTake(noReaders_, portMAX_DELAY);
+                    }
+                }
+
+                bool try_lock()
+                {
+                    if (!gate_.try_lock())
+                        return false;
+                    if (readers_.load(std::memory_order_acquire) > 0)
+                    {
+                        gate_.unlock();
+                        return false;
+                    }
+                    return true;
+                }
+
+                void unlock() { gate_.unlock(); }
+
+                // --- Lectores ---
+
+                void lock_shared()
+                {
+                    gate_.lock();
+                    readers_.fetch_add(1, std::memory_order_acquire);
+                    gate_.unlock();
+                }
+
+                bool try_lock_shared()
+                {
+                    if (!gate_.try_lock())
+                        return false;
+                    readers_.fetch_add(1, std::memory_order_acquire);
+                    gate_.unlock();
+                    return true;
+                }
+
+                void unlock_shared()
+                {
+                    if (readers_.fetch_sub(1, std::memory_order_release) == 1)
+                    {
+                        xSemaphoreGive(noReaders_); // Por si hay un escritor esperando
+                    }
+                }
+
+            private:
+                FreeRTOSLightMutex gate_;
+                std::atomic<int> readers_{0};
+                StaticSemaphore_t noReadersBuffer_;
+                SemaphoreHandle_t noReaders_;
+            };
+        }
+    }
+}
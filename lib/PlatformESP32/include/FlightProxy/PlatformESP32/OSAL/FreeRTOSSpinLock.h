@@ -0,0 +1,34 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+namespace FlightProxy
+{
+    namespace PlatformESP32
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Spinlock para secciones críticas muy cortas (unas pocas copias).
+             *
+             * Es una sección crítica de FreeRTOS con spinlock del port: desactiva las
+             * interrupciones del núcleo actual y espera activamente al otro núcleo.
+             * Dentro no se puede bloquear, llamar a la API de FreeRTOS ni loguear.
+             */
+            class FreeRTOSSpinLock
+            {
+            public:
+                FreeRTOSSpinLock() = default;
+
+                FreeRTOSSpinLock(const FreeRTOSSpinLock &) = delete;
+                FreeRTOSSpinLock &operator=(const FreeRTOSSpinLock &) = delete;
+
+                void lock() { portENTER_CRITICAL(&mux_); }
+                void unlock() { portEXIT_CRITICAL(&mux_); }
+
+            private:
+                portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+            };
+        }
+    }
+}
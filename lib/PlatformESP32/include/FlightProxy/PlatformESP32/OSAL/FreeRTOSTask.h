@@ -1,11 +1,13 @@
 #pragma once
 
 #include "FlightProxy/Core/OSAL/ITask.h"
+#include "FreeRTOSTaskProbe.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include <atomic>
+#include <memory>
 
 namespace FlightProxy
 {
@@ -82,6 +84,7 @@ namespace FlightProxy
                         // Para esta implementación genérica, forzamos la detención.
                         vTaskDelete(m_handle);
                         m_handle = nullptr;
+                        m_registration.reset(); // Su destructor ya no se ejecutará en la tarea
                         m_isTaskRunning = false;
                         // Liberamos el join por si alguien estaba esperando
                         xSemaphoreGive(m_joinSem);
@@ -110,11 +113,14 @@ namespace FlightProxy
                 {
                     FreeRTOSTask *self = static_cast<FreeRTOSTask *>(pvParameters);
 
+                    self->m_registration = registerCurrentTask(self->m_config);
+
                     // 1. Ejecuta la función del usuario
                     if (self->m_func)
                     {
                         self->m_func();
                     }
+                    self->m_registration.reset();
 
                     // 2. Marcar como finalizada
                     self->m_isTaskRunning = false;
@@ -135,6 +141,7 @@ namespace FlightProxy
                 TaskHandle_t m_handle = nullptr;
                 SemaphoreHandle_t m_joinSem = nullptr;
                 std::atomic<bool> m_isTaskRunning{false};
+                std::unique_ptr<Core::OSAL::TaskRegistry::Registration> m_registration;
             };
         } // namespace PlatformESP32
     } // namespace FlightProxy
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/TaskRegistry.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <memory>
+
+namespace FlightProxy
+{
+    namespace PlatformESP32
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Contadores de una tarea de FreeRTOS.
+             *
+             * La pila sale siempre de uxTaskGetStackHighWaterMark (en ESP-IDF, en bytes).
+             * El tiempo de CPU necesita CONFIG_FREERTOS_USE_TRACE_FACILITY y
+             * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS. FreeRTOS no cuenta cambios de
+             * contexto por tarea: el registro usa entonces los despertares del OSAL.
+             */
+            class FreeRTOSTaskProbe : public Core::OSAL::ITaskProbe
+            {
+            public:
+                // Se crea en la propia tarea
+                FreeRTOSTaskProbe() : handle_(xTaskGetCurrentTaskHandle()) {}
+
+                bool read(Core::OSAL::TaskCounters &counters) override
+                {
+                    counters.stackFreeBytes = uxTaskGetStackHighWaterMark(handle_);
+                    counters.hasStack = true;
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+                    TaskStatus_t status;
+                    // eReady evita que vTaskGetInfo consulte el estado (no lo usamos)
+                    vTaskGetInfo(handle_, &status, pdFALSE, eReady);
+
+                    // El contador por tarea puede ser de 32 bits: acumulamos las diferencias
+                    uint32_t rawRun = static_cast<uint32_t>(status.ulRunTimeCounter);
+                    uint32_t rawBase = static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE());
+                    if (started_)
+                    {
+                        runTime_ += uint32_t(rawRun - lastRun_);
+                        timeBase_ += uint32_t(rawBase - lastBase_);
+                    }
+                    lastRun_ = rawRun;
+                    lastBase_ = rawBase;
+                    started_ = true;
+
+                    counters.runTime = runTime_;
+                    counters.timeBase = timeBase_;
+                    counters.hasRunTime = true;
+#endif
+                    return true;
+                }
+
+            private:
+                TaskHandle_t handle_;
+
+                // Solo los toca read(), que el registro llama bajo su mutex
+                bool started_ = false;
+                uint32_t lastRun_ = 0;
+                uint32_t lastBase_ = 0;
+                uint64_t runTime_ = 0;
+                uint64_t timeBase_ = 0;
+            };
+
+            // Alta de la tarea actual en el registro (para tareas creadas con xTaskCreate)
+            inline std::unique_ptr<Core::OSAL::TaskRegistry::Registration> registerCurrentTask(const Core::OSAL::TaskConfig &config)
+            {
+                return std::make_unique<Core::OSAL::TaskRegistry::Registration>(config, std::make_unique<FreeRTOSTaskProbe>());
+            }
+        }
+    }
+}
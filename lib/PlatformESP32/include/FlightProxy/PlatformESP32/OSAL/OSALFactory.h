@@ -3,11 +3,23 @@
 #include "FlightProxy/Core/OSAL/ITask.h"
 #include "FlightProxy/Core/OSAL/IQueue.h"
 #include "FlightProxy/Core/OSAL/IMutex.h"
+#include "FlightProxy/Core/OSAL/IEventFlags.h"
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+#include "FlightProxy/Core/OSAL/IBlockPool.h"
+#include "FlightProxy/Core/Utils/FixedBlockPool.h"
 
 #include "FreeRTOSTask.h"
 #include "FreeRTOSQueue.h"
 #include "FreeRTOSMutex.h"
+#include "FreeRTOSEventFlags.h"
+#include "FreeRTOSLightMutex.h"
+#include "FreeRTOSSpinLock.h"
+#include "FreeRTOSSharedMutex.h"
 
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+#include <cstddef>
 #include <memory>
 
 namespace FlightProxy
@@ -19,17 +31,49 @@ namespace FlightProxy
 
             struct OSALFactory
             {
+                // Locks por tipo concreto (sin vtable), ver Core/OSAL/Locks.h
+                using Mutex = FreeRTOSLightMutex;
+                using SpinLock = FreeRTOSSpinLock;
+                using SharedMutex = FreeRTOSSharedMutex;
+
                 template <typename T>
                 static std::unique_ptr<Core::OSAL::IQueue<T>> createQueue(size_t size)
                 {
                     return std::make_unique<FreeRTOSQueue<T>>(size);
                 }
 
+                // Con nombre: instrumentada si se compila con FP_ENABLE_CONTENTION_STATS
+                template <typename T>
+                static std::unique_ptr<Core::OSAL::IQueue<T>> createQueue(size_t size, const char *name)
+                {
+#if defined(FP_ENABLE_CONTENTION_STATS)
+                    return std::make_unique<Core::OSAL::InstrumentedQueue<T>>(createQueue<T>(size), size, name);
+#else
+                    (void)name;
+                    return createQueue<T>(size);
+#endif
+                }
+
                 static std::unique_ptr<Core::OSAL::IMutex> createMutex()
                 {
                     return std::make_unique<FreeRTOSMutex>();
                 }
 
+                static std::unique_ptr<Core::OSAL::IMutex> createMutex(const char *name)
+                {
+#if defined(FP_ENABLE_CONTENTION_STATS)
+                    return std::make_unique<Core::OSAL::InstrumentedMutex>(createMutex(), name);
+#else
+                    (void)name;
+                    return createMutex();
+#endif
+                }
+
+                static std::unique_ptr<Core::OSAL::IEventFlags> createEventFlags()
+                {
+                    return std::make_unique<FreeRTOSEventFlags>();
+                }
+
                 static std::unique_ptr<Core::OSAL::ITask> createTask(
                     Core::OSAL::ITask::TaskFunction func,
                     const Core::OSAL::TaskConfig &config = Core::OSAL::TaskConfig())
@@ -37,16 +81,46 @@ namespace FlightProxy
                     return std::make_unique<FreeRTOSTask>(func, config);
                 }
 
+                // Pool de bloques fijos en RAM interna, reservado una sola vez
+                static std::unique_ptr<Core::OSAL::IBlockPool> createBlockPool(size_t blockSize, size_t blockCount)
+                {
+                    return std::make_unique<Core::Utils::FixedBlockPool>(blockSize, blockCount,
+                                                                         &allocPoolStorage, &freePoolStorage);
+                }
+
                 static void sleep(uint32_t ms)
                 {
                     vTaskDelay(pdMS_TO_TICKS(ms));
                 }
 
+                // Núcleos en los que pueden correr tareas
+                static size_t getCoreCount()
+                {
+                    return portNUM_PROCESSORS;
+                }
+
                 // Get current ms time
                 static uint64_t getSystemTimeMs()
                 {
                     return static_cast<uint64_t>(xTaskGetTickCount()) * portTICK_PERIOD_MS;
                 }
+
+                // Tiempo monótono en microsegundos desde el arranque (no depende del tick)
+                static uint64_t getMonotonicTimeUs()
+                {
+                    return static_cast<uint64_t>(esp_timer_get_time());
+                }
+
+            private:
+                static void *allocPoolStorage(size_t bytes)
+                {
+                    return heap_caps_aligned_alloc(alignof(std::max_align_t), bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+                }
+
+                static void freePoolStorage(void *storage)
+                {
+                    heap_caps_free(storage);
+                }
             };
         }
     }
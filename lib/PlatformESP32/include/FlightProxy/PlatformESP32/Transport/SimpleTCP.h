@@ -1,5 +1,6 @@
 #pragma once
 #include "FlightProxy/Core/Transport/ITransport.h"
+#include "FlightProxy/Core/Transport/AsyncTxQueue.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
 
 #include "freertos/FreeRTOS.h"
@@ -17,23 +18,40 @@ namespace FlightProxy
                               public std::enable_shared_from_this<SimpleTCP>
             {
             public:
-                SimpleTCP(int accepted_socket);
-                SimpleTCP(const char *ip, uint16_t port);
+                SimpleTCP(int accepted_socket, const Core::Transport::AsyncTxConfig &txConfig = Core::Transport::AsyncTxConfig());
+                SimpleTCP(const char *ip, uint16_t port, const Core::Transport::AsyncTxConfig &txConfig = Core::Transport::AsyncTxConfig());
                 ~SimpleTCP() override;
 
                 void open() override;
                 void close() override;
+
+                // Todos encolan y vuelven: el ::send bloqueante lo hace la tarea de TX
                 void send(const uint8_t *data, size_t len) override;
+                bool trySend(const uint8_t *data, size_t len) override;
+                bool trySendFrame(const Core::Utils::ByteView &frame) override;
+                void sendv(const Core::Transport::IoSlice *slices, size_t count) override;
+                bool trySendv(const Core::Transport::IoSlice *slices, size_t count) override;
+                size_t pendingTxBytes() const override;
 
             private:
+                static constexpr size_t kMaxTxBatch = 8; // Tramas por llamada a writev
+                static constexpr size_t kRxChunkCount = Core::Utils::RxChunkPool::kDefaultChunkCount; // Bloques de recepción en el pool
+
                 int m_sock = -1;
                 uint16_t port_ = -1;
                 char ip_[16];
 
                 TaskHandle_t eventTaskHandle_;
+                TaskHandle_t txTaskHandle_ = nullptr;
                 std::unique_ptr<Core::OSAL::IMutex> mutex_;
+                Core::Transport::AsyncTxQueue txQueue_;
+
                 void eventTask(std::shared_ptr<SimpleTCP> *self_keep_alive);
                 static void eventTaskAdapter(void *arg);
+                void txTask(std::shared_ptr<SimpleTCP> *self_keep_alive);
+                static void txTaskAdapter(void *arg);
+                void bindTxCallbacks();
+                bool isOpenForTx() const;
             };
         }
     }
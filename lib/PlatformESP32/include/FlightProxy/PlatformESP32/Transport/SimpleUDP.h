@@ -1,6 +1,7 @@
 #pragma once
 #include "FlightProxy/Core/Transport/ITransport.h"
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/Locks.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -34,15 +35,24 @@ namespace FlightProxy
                  * este es el comportamiento más lógico para un socket UDP de escucha.
                  */
                 void send(const uint8_t *data, size_t len) override;
+                void sendv(const Core::Transport::IoSlice *slices, size_t count) override;
 
             private:
+                static constexpr size_t kMaxSlices = 8; // Trozos por datagrama en sendv()
+                static constexpr size_t kRxChunkCount = Core::Utils::RxChunkPool::kDefaultChunkCount; // Bloques de recepción en el pool
+
                 int m_sock = -1;
                 uint16_t m_port; // Puerto en el que escuchamos
 
-                // Almacena la dirección del último remitente para el método send()
+                // Almacena la dirección del último remitente para el método send().
+                // La RX lo actualiza en cada datagrama: lo protege un spinlock propio
+                // para no esperar a un send() que tenga mutex_ durante el sendto().
                 struct sockaddr_in m_last_sender_addr;
                 socklen_t m_last_sender_len;
                 bool m_has_last_sender = false; // Flag para saber si podemos enviar
+                Core::OSAL::SpinLock senderLock_;
+
+                bool lastSender(struct sockaddr_in &addr, socklen_t &len);
 
                 TaskHandle_t eventTaskHandle_;
                 std::unique_ptr<Core::OSAL::IMutex> mutex_;
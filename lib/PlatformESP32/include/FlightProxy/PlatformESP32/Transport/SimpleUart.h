@@ -23,8 +23,11 @@ namespace FlightProxy
                 void open() override;
                 void close() override;
                 void send(const uint8_t *data, size_t len) override;
+                void sendv(const Core::Transport::IoSlice *slices, size_t count) override;
 
             private:
+                static constexpr size_t kRxChunkCount = Core::Utils::RxChunkPool::kDefaultChunkCount; // Bloques de recepción en el pool
+
                 uart_port_t port_;
                 gpio_num_t txpin_;
                 gpio_num_t rxpin_;
@@ -32,7 +35,7 @@ namespace FlightProxy
 
                 TaskHandle_t eventTaskHandle_;
                 QueueHandle_t queue_;
-                uint8_t *rxBuffer_;
+                std::unique_ptr<Core::Utils::RxChunkPool> rxPool_;
                 size_t rxbuffersize_;
                 std::unique_ptr<Core::OSAL::IMutex> mutex_;
 
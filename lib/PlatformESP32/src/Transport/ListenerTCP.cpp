@@ -1,6 +1,7 @@
 #include "FlightProxy/PlatformESP32/Transport/ListenerTCP.h"
 #include "FlightProxy/PlatformESP32/Transport/SimpleTCP.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformESP32/OSAL/FreeRTOSTaskProbe.h"
 #include "FlightProxy/Core/Utils/MutexGuard.h"
 
 #include "lwip/sockets.h"
@@ -14,7 +15,7 @@ namespace FlightProxy
         {
             static const char *TAG = "ListenerTCP";
 
-            ListenerTCP::ListenerTCP() : m_mutex(Core::OSAL::Factory::createMutex())
+            ListenerTCP::ListenerTCP() : m_mutex(Core::OSAL::Factory::createMutex("ListenerTCP"))
             {
             }
 
@@ -139,7 +140,10 @@ namespace FlightProxy
                 ListenerTCP *listener = static_cast<ListenerTCP *>(arg);
 
                 // La tarea se ejecuta...
-                listener->listenerTask();
+                {
+                    auto registration = OSAL::registerCurrentTask({"tcp_listener_task", 4096, 5, -1});
+                    listener->listenerTask();
+                }
 
                 // ... y cuando termina, se auto-elimina.
                 vTaskDelete(NULL);
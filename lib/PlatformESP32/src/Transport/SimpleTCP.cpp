@@ -1,5 +1,6 @@
 #include "FlightProxy/PlatformESP32/Transport/SimpleTCP.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformESP32/OSAL/FreeRTOSTaskProbe.h"
 
 #include "lwip/sockets.h"
 #include "lwip/netdb.h" // Para getaddrinfo
@@ -14,17 +15,21 @@ namespace FlightProxy
         {
             static const char *TAG = "SimpleTCP";
 
-            SimpleTCP::SimpleTCP(int accepted_socket)
+            SimpleTCP::SimpleTCP(int accepted_socket, const Core::Transport::AsyncTxConfig &txConfig)
                 : m_sock(accepted_socket), port_(0), eventTaskHandle_(nullptr),
-                  mutex_(Core::OSAL::Factory::createMutex())
+                  mutex_(Core::OSAL::Factory::createMutex("SimpleTCP")),
+                  txQueue_(txConfig)
             {
                 ip_[0] = '\0';
+                bindTxCallbacks();
             }
 
-            SimpleTCP::SimpleTCP(const char *ip, uint16_t port)
+            SimpleTCP::SimpleTCP(const char *ip, uint16_t port, const Core::Transport::AsyncTxConfig &txConfig)
                 : m_sock(-1), port_(port), eventTaskHandle_(nullptr),
-                  mutex_(Core::OSAL::Factory::createMutex())
+                  mutex_(Core::OSAL::Factory::createMutex("SimpleTCP")),
+                  txQueue_(txConfig)
             {
+                bindTxCallbacks();
                 if (ip != nullptr)
                 {
                     // Copia como máximo 15 caracteres para dejar espacio para el '\0'
@@ -45,6 +50,22 @@ namespace FlightProxy
                 FP_LOG_I(TAG, "Canal destruido.");
             }
 
+            void SimpleTCP::bindTxCallbacks()
+            {
+                // Las marcas de la cola de TX se reflejan en los callbacks del transporte
+                txQueue_.onHigh = [this]()
+                {
+                    FP_LOG_W(TAG, "Cola de TX por encima de la marca alta (%u bytes)", (unsigned)txQueue_.pendingBytes());
+                    if (onBackpressure)
+                        onBackpressure();
+                };
+                txQueue_.onLow = [this]()
+                {
+                    if (onWritable)
+                        onWritable();
+                };
+            }
+
             void SimpleTCP::open()
             {
                 std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
@@ -120,7 +141,24 @@ namespace FlightProxy
                     }
                     return; // Salir de la función
                 }
-                // 2. Creamos un puntero en el HEAP para pasar el shared_ptr a la tarea.
+                // 2. Tarea de TX: es la única que hace ::send, así nadie más bloquea en el socket
+                txQueue_.reopen();
+                auto *tx_arg = new std::shared_ptr<SimpleTCP>(self_keep_alive);
+                if (xTaskCreate(txTaskAdapter, "tcp_tx_task", 3072, tx_arg, 5, &txTaskHandle_) != pdPASS)
+                {
+                    txTaskHandle_ = nullptr;
+                    delete tx_arg;
+                    FP_LOG_E(TAG, "Error al crear la tarea de TX TCP");
+
+                    if (m_sock != -1)
+                    {
+                        ::close(m_sock);
+                        m_sock = -1;
+                    }
+                    return;
+                }
+
+                // 3. Creamos un puntero en el HEAP para pasar el shared_ptr a la tarea.
                 //    La tarea será responsable de borrar este puntero.
                 auto *task_arg = new std::shared_ptr<SimpleTCP>(std::move(self_keep_alive));
 
@@ -140,10 +178,14 @@ namespace FlightProxy
 
                     delete task_arg; // Liveramos memoria pq el task no la va a liberar
 
+                    // La tarea de TX sale sola al cerrar la cola
+                    txQueue_.close();
                     if (m_sock != -1)
                     {
-                        ::close(m_sock);
+                        int sock = m_sock;
                         m_sock = -1;
+                        txQueue_.waitWriterDone(1000);
+                        ::close(sock);
                     }
                 }
             }
@@ -166,34 +208,151 @@ namespace FlightProxy
 
             void SimpleTCP::send(const uint8_t *data, size_t len)
             {
-                std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
-
-                if (m_sock == -1)
+                if (!trySend(data, len))
                 {
-                    FP_LOG_W(TAG, "Canal: Intento de envío en socket cerrado.");
-                    return;
+                    FP_LOG_W(TAG, "Canal: cola de TX llena o cerrada, %u bytes descartados.", (unsigned)len);
                 }
+            }
+
+            bool SimpleTCP::trySend(const uint8_t *data, size_t len)
+            {
+                if (!isOpenForTx())
+                    return false;
                 if (data == nullptr || len == 0)
                 {
                     FP_LOG_W(TAG, "Canal: Intento de envío datos vacios.");
-                    return;
+                    return false;
+                }
+
+                // Solo copia a la cola; nunca espera al socket
+                return txQueue_.push(data, len);
+            }
+
+            bool SimpleTCP::trySendFrame(const Core::Utils::ByteView &frame)
+            {
+                if (!isOpenForTx())
+                    return false;
+
+                // La cola comparte la trama (sin copia); se libera cuando sale por el socket
+                return txQueue_.pushFrame(frame);
+            }
+
+            void SimpleTCP::sendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                if (!trySendv(slices, count))
+                {
+                    FP_LOG_W(TAG, "Canal: cola de TX llena o cerrada, trama de %u trozos descartada.", (unsigned)count);
+                }
+            }
+
+            bool SimpleTCP::trySendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                if (!isOpenForTx())
+                    return false;
+
+                // Los trozos se copian una vez, directamente a un bloque reservado de la cola
+                return txQueue_.pushv(slices, count);
+            }
+
+            bool SimpleTCP::isOpenForTx() const
+            {
+                std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+                if (m_sock == -1)
+                {
+                    FP_LOG_W(TAG, "Canal: Intento de envío en socket cerrado.");
+                    return false;
                 }
-                // Tenemos que asegurarnos que todo el contenido de data se envia
-                size_t total_sent = 0;
-                while (total_sent < len)
+                return true;
+            }
+
+            size_t SimpleTCP::pendingTxBytes() const
+            {
+                return txQueue_.pendingBytes();
+            }
+
+            void SimpleTCP::txTaskAdapter(void *arg)
+            {
+                auto *self_ptr_on_heap = static_cast<std::shared_ptr<SimpleTCP> *>(arg);
+                SimpleTCP *instance = self_ptr_on_heap->get();
+                instance->txTask(self_ptr_on_heap);
+            }
+
+            void SimpleTCP::txTask(std::shared_ptr<SimpleTCP> *self_ptr_on_heap)
+            {
+                std::shared_ptr<SimpleTCP> self = std::move(*self_ptr_on_heap);
+                delete self_ptr_on_heap;
+                auto registration = OSAL::registerCurrentTask({"tcp_tx_task", 3072, 5, -1});
+
+                std::vector<Core::Utils::ByteView> batch;
+                struct iovec iov[kMaxTxBatch];
+                while (true)
                 {
-                    int sent_now = ::send(m_sock, data + total_sent, len - total_sent, 0);
-                    if (sent_now < 0)
+                    if (txQueue_.popBatch(batch, kMaxTxBatch, 1000) == 0)
                     {
-                        FP_LOG_E(TAG, "Canal (socket %d): Error en send(): %d. Abortando envío.", m_sock, errno);
+                        if (txQueue_.isClosed())
+                            break;
+                        continue;
+                    }
 
-                        // Si el envío falla, es un error grave.
-                        // Cerramos la conexión para notificar a la tarea.
-                        ::shutdown(m_sock, SHUT_RDWR);
-                        return;
+                    int sock;
+                    {
+                        std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+                        sock = m_sock;
+                    }
+
+                    size_t batch_bytes = 0;
+                    for (size_t i = 0; i < batch.size(); ++i)
+                    {
+                        iov[i].iov_base = const_cast<uint8_t *>(batch[i].data());
+                        iov[i].iov_len = batch[i].size();
+                        batch_bytes += batch[i].size();
+                    }
+
+                    // Todo el lote en una llamada (writev). Tenemos que asegurarnos que todo
+                    // el contenido se envia. Sin el mutex: si el par va lento solo se bloquea esta tarea.
+                    struct iovec *pending = iov;
+                    int pending_count = static_cast<int>(batch.size());
+                    while (sock != -1 && pending_count > 0)
+                    {
+                        int sent_now = ::writev(sock, pending, pending_count);
+                        if (sent_now < 0)
+                        {
+                            FP_LOG_E(TAG, "Canal (socket %d): Error en writev(): %d. Abortando envío.", sock, errno);
+
+                            // Si el envío falla, es un error grave.
+                            // Cerramos la conexión para notificar a la tarea de eventos.
+                            ::shutdown(sock, SHUT_RDWR);
+                            break;
+                        }
+
+                        // Envío parcial: saltamos los trozos completos y recortamos el siguiente
+                        size_t advance = static_cast<size_t>(sent_now);
+                        while (pending_count > 0 && advance >= pending->iov_len)
+                        {
+                            advance -= pending->iov_len;
+                            pending++;
+                            pending_count--;
+                        }
+                        if (pending_count > 0)
+                        {
+                            pending->iov_base = static_cast<uint8_t *>(pending->iov_base) + advance;
+                            pending->iov_len -= advance;
+                        }
                     }
-                    total_sent += sent_now;
+                    batch.clear(); // Suelta las tramas (y sus bloques) antes de avisar de la marca baja
+                    txQueue_.done(batch_bytes);
+                }
+
+                {
+                    std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+                    txTaskHandle_ = nullptr;
                 }
+                txQueue_.signalWriterDone();
+
+                FP_LOG_I(TAG, "Tarea de TX terminada.");
+                self.reset(); // vTaskDelete no vuelve: soltamos la referencia antes
+                registration.reset();
+                vTaskDelete(NULL);
             }
 
             void SimpleTCP::eventTaskAdapter(void *arg)
@@ -216,6 +375,7 @@ namespace FlightProxy
 
                 // 2. Borramos el puntero del heap (que ahora está vacío)
                 delete self_ptr_on_heap;
+                auto registration = OSAL::registerCurrentTask({"tcp_event_task", 4096, 5, -1});
 
                 // Ahora 'self' (en el stack de esta tarea) mantendrá el objeto
                 // SimpleTCP vivo mientras la tarea se ejecute.
@@ -225,23 +385,23 @@ namespace FlightProxy
                     onOpen();
                 }
 
-                std::vector<uint8_t> rx_buffer(1024);
+                // Bloques de recepción reutilizables: los paquetes decodificados pueden
+                // apuntar a ellos (onChunk) y el bloque vuelve al pool al liberarlos
+                Core::Utils::RxChunkPool rx_pool(1024, kRxChunkCount);
 
                 FP_LOG_I(TAG, "Tarea Iniciada.");
 
                 // 5. Bucle de lectura
                 while (true)
                 {
-                    int len = ::recv(m_sock, rx_buffer.data(), rx_buffer.size(), 0);
+                    std::shared_ptr<Core::Utils::RxChunk> chunk = rx_pool.acquire();
+                    int len = ::recv(m_sock, chunk->bytes.data(), chunk->bytes.size(), 0);
 
                     if (len > 0)
                     {
-                        if (onData)
-                        {
-                            FP_LOG_I(TAG, "Recibido %d bytes.", len);
-                            FP_LOG_I(TAG, "Contenido: %.*s", len, rx_buffer.data());
-                            onData(rx_buffer.data(), len);
-                        }
+                        FP_LOG_I(TAG, "Recibido %d bytes.", len);
+                        FP_LOG_I(TAG, "Contenido: %.*s", len, chunk->bytes.data());
+                        deliverRx(chunk, len);
                     }
                     else if (len == 0)
                     {
@@ -274,9 +434,17 @@ namespace FlightProxy
                     eventTaskHandle_ = nullptr;
                 } // El mutex se libera aquí
 
-                // 2. Limpiamos los recursos (socket) FUERA del mutex
+                // 2. Limpiamos los recursos (socket) FUERA del mutex.
+                //    Antes paramos la tarea de TX: el shutdown desbloquea un ::send en curso
+                //    y esperamos a que salga para no cerrar un descriptor que aún usa.
                 if (sock_to_close != -1)
                 {
+                    ::shutdown(sock_to_close, SHUT_RDWR);
+                    txQueue_.close();
+                    if (!txQueue_.waitWriterDone(1000))
+                    {
+                        FP_LOG_W(TAG, "La tarea de TX no terminó a tiempo.");
+                    }
                     ::close(sock_to_close);
                 }
 
@@ -289,6 +457,7 @@ namespace FlightProxy
                 }
 
                 FP_LOG_I(TAG, "Tarea terminada.");
+                registration.reset();
                 vTaskDelete(NULL); // La tarea se autodestruye
                 // Esto destruirá 'self' (el shared_ptr), y si es la última
                 // referencia, el objeto SimpleTCP se borrará de forma segura.
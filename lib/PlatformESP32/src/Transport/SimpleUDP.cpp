@@ -1,5 +1,6 @@
 #include "FlightProxy/PlatformESP32/Transport/SimpleUDP.h" // Asegúrate de que la ruta sea correcta
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformESP32/OSAL/FreeRTOSTaskProbe.h"
 
 #include "lwip/sockets.h"
 #include <vector>
@@ -18,7 +19,7 @@ namespace FlightProxy
                   m_last_sender_len(sizeof(m_last_sender_addr)),
                   m_has_last_sender(false),
                   eventTaskHandle_(nullptr),
-                  mutex_(Core::OSAL::Factory::createMutex())
+                  mutex_(Core::OSAL::Factory::createMutex("SimpleUDP"))
             {
                 memset(&m_last_sender_addr, 0, sizeof(m_last_sender_addr));
                 FP_LOG_I(TAG, "Canal UDP creado para el puerto %u", m_port);
@@ -131,7 +132,9 @@ namespace FlightProxy
                     FP_LOG_W(TAG, "Canal: Intento de envío en socket cerrado.");
                     return;
                 }
-                if (!m_has_last_sender)
+                struct sockaddr_in dest;
+                socklen_t dest_len;
+                if (!lastSender(dest, dest_len))
                 {
                     FP_LOG_W(TAG, "Canal: Intento de envío sin un destinatario (aún no se ha recibido nada).");
                     return;
@@ -144,8 +147,8 @@ namespace FlightProxy
 
                 // Enviar al último remitente conocido
                 int sent_now = ::sendto(m_sock, data, len, 0,
-                                        (struct sockaddr *)&m_last_sender_addr,
-                                        m_last_sender_len);
+                                        (struct sockaddr *)&dest,
+                                        dest_len);
 
                 if (sent_now < 0)
                 {
@@ -155,6 +158,52 @@ namespace FlightProxy
                 }
             }
 
+            void SimpleUDP::sendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+
+                struct sockaddr_in dest;
+                socklen_t dest_len;
+                if (m_sock == -1 || !lastSender(dest, dest_len))
+                {
+                    FP_LOG_W(TAG, "Canal: Intento de envío en socket cerrado o sin destinatario.");
+                    return;
+                }
+                if (count == 0 || count > kMaxSlices)
+                {
+                    FP_LOG_W(TAG, "Canal: Número de trozos no válido (%u).", (unsigned)count);
+                    return;
+                }
+
+                // Un solo datagrama con todos los trozos (sendmsg), sin aplanarlos antes
+                struct iovec iov[kMaxSlices];
+                for (size_t i = 0; i < count; ++i)
+                {
+                    iov[i].iov_base = const_cast<uint8_t *>(slices[i].data);
+                    iov[i].iov_len = slices[i].len;
+                }
+
+                struct msghdr msg;
+                memset(&msg, 0, sizeof(msg));
+                msg.msg_name = &dest;
+                msg.msg_namelen = dest_len;
+                msg.msg_iov = iov;
+                msg.msg_iovlen = count;
+
+                if (::sendmsg(m_sock, &msg, 0) < 0)
+                {
+                    FP_LOG_E(TAG, "Canal (socket %d): Error en sendmsg(): %d.", m_sock, errno);
+                }
+            }
+
+            bool SimpleUDP::lastSender(struct sockaddr_in &addr, socklen_t &len)
+            {
+                std::lock_guard<Core::OSAL::SpinLock> lock(senderLock_);
+                addr = m_last_sender_addr;
+                len = m_last_sender_len;
+                return m_has_last_sender;
+            }
+
             // --- Tareas (Adaptador y Tarea de Eventos) ---
 
             void SimpleUDP::eventTaskAdapter(void *arg)
@@ -176,6 +225,7 @@ namespace FlightProxy
 
                 // 2. Borramos el puntero del heap
                 delete self_ptr_on_heap;
+                auto registration = OSAL::registerCurrentTask({"udp_event_task", 4096, 5, -1});
 
                 // 'self' mantendrá el objeto vivo
                 if (onOpen)
@@ -183,8 +233,9 @@ namespace FlightProxy
                     onOpen();
                 }
 
-                // Un buffer más grande es apropiado para UDP (cerca de MTU)
-                std::vector<uint8_t> rx_buffer(1500);
+                // Un buffer más grande es apropiado para UDP (cerca de MTU).
+                // Bloques reutilizables: los paquetes decodificados pueden apuntar a ellos.
+                Core::Utils::RxChunkPool rx_pool(1500, kRxChunkCount);
 
                 FP_LOG_I(TAG, "Tarea Iniciada.");
 
@@ -195,28 +246,26 @@ namespace FlightProxy
                     struct sockaddr_in sender_addr;
                     socklen_t sender_len = sizeof(sender_addr);
 
-                    int len = ::recvfrom(m_sock, rx_buffer.data(), rx_buffer.size(), 0,
+                    std::shared_ptr<Core::Utils::RxChunk> chunk = rx_pool.acquire();
+                    int len = ::recvfrom(m_sock, chunk->bytes.data(), chunk->bytes.size(), 0,
                                          (struct sockaddr *)&sender_addr, &sender_len);
 
                     if (len > 0)
                     {
                         // Guardar el remitente para futuros 'send()'
                         {
-                            std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+                            std::lock_guard<Core::OSAL::SpinLock> lock(senderLock_);
                             m_last_sender_addr = sender_addr;
                             m_last_sender_len = sender_len;
                             m_has_last_sender = true;
                         }
 
-                        if (onData)
-                        {
-                            // Opcional: Loguear de quién recibimos
-                            char sender_ip[INET_ADDRSTRLEN];
-                            inet_ntop(AF_INET, &sender_addr.sin_addr, sender_ip, INET_ADDRSTRLEN);
-                            FP_LOG_I(TAG, "Recibido %d bytes de %s:%u", len, sender_ip, ntohs(sender_addr.sin_port));
-                            FP_LOG_I(TAG, "Contenido: %.*s", len, rx_buffer.data());
-                            onData(rx_buffer.data(), len);
-                        }
+                        // Opcional: Loguear de quién recibimos
+                        char sender_ip[INET_ADDRSTRLEN];
+                        inet_ntop(AF_INET, &sender_addr.sin_addr, sender_ip, INET_ADDRSTRLEN);
+                        FP_LOG_I(TAG, "Recibido %d bytes de %s:%u", len, sender_ip, ntohs(sender_addr.sin_port));
+                        FP_LOG_I(TAG, "Contenido: %.*s", len, chunk->bytes.data());
+                        deliverRx(chunk, len);
                     }
                     else if (len == 0)
                     {
@@ -243,6 +292,9 @@ namespace FlightProxy
                         m_sock = -1;
                     }
                     eventTaskHandle_ = nullptr;
+                }
+                {
+                    std::lock_guard<Core::OSAL::SpinLock> lock(senderLock_);
                     m_has_last_sender = false; // Invalidar el remitente
                 }
 
@@ -257,6 +309,7 @@ namespace FlightProxy
                 }
 
                 FP_LOG_I(TAG, "Tarea terminada.");
+                registration.reset();
                 vTaskDelete(NULL); // La tarea se autodestruye
             }
         } // namespace Transport
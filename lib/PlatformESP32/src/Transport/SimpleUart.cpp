@@ -1,5 +1,8 @@
 #include "FlightProxy/PlatformESP32/Transport/SimpleUart.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformESP32/OSAL/FreeRTOSTaskProbe.h"
+
+#include <new> // Para std::nothrow
 
 namespace FlightProxy
 {
@@ -11,8 +14,8 @@ namespace FlightProxy
 
             SimpleUart::SimpleUart(uart_port_t port, gpio_num_t txpin, gpio_num_t rxpin, uint32_t baudrate)
                 : port_(port), txpin_(txpin), rxpin_(rxpin), baudrate_(baudrate), eventTaskHandle_(nullptr),
-                  queue_(nullptr), rxBuffer_(nullptr), rxbuffersize_(1024),
-                  mutex_(Core::OSAL::Factory::createMutex())
+                  queue_(nullptr), rxbuffersize_(1024),
+                  mutex_(Core::OSAL::Factory::createMutex("SimpleUart"))
             {
             }
 
@@ -46,11 +49,11 @@ namespace FlightProxy
                 // y se crea una cola de eventos
                 ESP_ERROR_CHECK(uart_driver_install(port_, rxbuffersize_, 0, 20, &queue_, 0));
 
-                // 4. Asignar memoria para el buffer de recepción temporal
-                // distinto del buffer del driver. este es propiedad de la clase
-                rxBuffer_ = (uint8_t *)malloc(rxbuffersize_);
+                // 4. Bloques de recepción, distintos del buffer del driver. Los paquetes
+                // decodificados pueden apuntar a ellos (onChunk) sin copiar los bytes.
+                rxPool_.reset(new (std::nothrow) Core::Utils::RxChunkPool(rxbuffersize_, kRxChunkCount));
 
-                if (rxBuffer_ == nullptr)
+                if (rxPool_ == nullptr)
                 {
                     FP_LOG_E(TAG, "Failed to allocate memory for RX buffer");
                     uart_driver_delete(port_); // Limpiamos driver al ver fallo
@@ -81,8 +84,7 @@ namespace FlightProxy
                 {
                     FP_LOG_E(TAG, "Fallo al crear la tere UART");
                     delete task_arg;
-                    free(rxBuffer_);
-                    rxBuffer_ = nullptr;
+                    rxPool_.reset();
                     uart_driver_delete(port_);
                     eventTaskHandle_ = nullptr;
                 }
@@ -102,7 +104,7 @@ namespace FlightProxy
                 std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
 
                 // Comprovamos si la tarea buffer siguen vivos
-                if (rxBuffer_ == nullptr || eventTaskHandle_ == nullptr)
+                if (rxPool_ == nullptr || eventTaskHandle_ == nullptr)
                 {
                     FP_LOG_W(TAG, "Intento de envío en UART cerrada.");
                     return;
@@ -115,6 +117,24 @@ namespace FlightProxy
                 uart_write_bytes(port_, (const char *)data, len);
             }
 
+            void SimpleUart::sendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
+
+                if (rxPool_ == nullptr || eventTaskHandle_ == nullptr)
+                {
+                    FP_LOG_W(TAG, "Intento de envío en UART cerrada.");
+                    return;
+                }
+
+                // Cada trozo va directo al driver; el mutex evita que se intercalen tramas
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (slices[i].data != nullptr && slices[i].len > 0)
+                        uart_write_bytes(port_, (const char *)slices[i].data, slices[i].len);
+                }
+            }
+
             void SimpleUart::eventTaskAdapter(void *arg)
             {
                 // 1. Recibimos el puntero al shared_ptr que está en el heap
@@ -135,6 +155,7 @@ namespace FlightProxy
 
                 // 2. Borramos el puntero del heap (que ahora está vacío)
                 delete self_ptr_on_heap;
+                auto registration = OSAL::registerCurrentTask({"uart_event_task", 4096, 10, -1});
 
                 // Ahora 'self' (en el stack de esta tarea) mantendrá el objeto
                 // SimpleUart vivo mientras la tarea se ejecute.
@@ -164,16 +185,14 @@ namespace FlightProxy
                             // Limitar la lectura al tamaño de nuestro buffer
                             size_t read_len = (buffered_len > rxbuffersize_) ? rxbuffersize_ : buffered_len;
 
-                            // Leer los datos del buffer interno de la UART a nuestro rxBuffer_
-                            int rxBytes = uart_read_bytes(port_, rxBuffer_, read_len, pdMS_TO_TICKS(20));
+                            // Leer los datos del buffer interno de la UART a un bloque del pool
+                            std::shared_ptr<Core::Utils::RxChunk> chunk = rxPool_->acquire();
+                            int rxBytes = uart_read_bytes(port_, chunk->bytes.data(), read_len, pdMS_TO_TICKS(20));
 
                             if (rxBytes > 0)
                             {
-                                // Llamar al callback onData si está definido
-                                if (onData)
-                                {
-                                    onData(rxBuffer_, rxBytes);
-                                }
+                                // Llamar al callback onChunk / onData si está definido
+                                deliverRx(chunk, rxBytes);
                             }
                         }
                         break;
@@ -224,11 +243,8 @@ namespace FlightProxy
                 {
                     std::lock_guard<Core::OSAL::IMutex> lock(*mutex_);
                     // Hacemos la limpieza
-                    if (rxBuffer_ != nullptr)
-                    {
-                        free(rxBuffer_);
-                        rxBuffer_ = nullptr;
-                    }
+                    // Los bloques que sigan retenidos por paquetes se liberan con ellos
+                    rxPool_.reset();
                     eventTaskHandle_ = nullptr;
                     // 'queue_' ya está liberada por uart_driver_delete()
                 }
@@ -239,6 +255,7 @@ namespace FlightProxy
                     onClose();
                 }
 
+                registration.reset();
                 vTaskDelete(NULL);
             }
         }
@@ -3,7 +3,21 @@
 #include "WinTask.h"
 #include "WinQueue.h"
 #include "WinMutex.h"
+#include "WinEventFlags.h"
+#include "WinSpinLock.h"
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+#include "FlightProxy/Core/OSAL/IBlockPool.h"
+#include "FlightProxy/Core/Utils/FixedBlockPool.h"
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
 
 namespace FlightProxy
 {
@@ -13,6 +27,10 @@ namespace FlightProxy
         {
             struct OSALFactory
             {
+                // Locks por tipo concreto (sin vtable), ver Core/OSAL/Locks.h
+                using Mutex = std::mutex;
+                using SpinLock = OSAL::WinSpinLock;
+                using SharedMutex = std::shared_mutex;
 
                 // Factoría de Tareas
                 static std::unique_ptr<Core::OSAL::ITask> createTask(Core::OSAL::ITask::TaskFunction func, const Core::OSAL::TaskConfig &config)
@@ -27,18 +45,60 @@ namespace FlightProxy
                     return std::make_unique<OSAL::WinQueue<T>>(queueLength);
                 }
 
+                // Con nombre: instrumentada si se compila con FP_ENABLE_CONTENTION_STATS
+                template <typename T>
+                static std::unique_ptr<Core::OSAL::IQueue<T>> createQueue(uint32_t queueLength, const char *name)
+                {
+#if defined(FP_ENABLE_CONTENTION_STATS)
+                    return std::make_unique<Core::OSAL::InstrumentedQueue<T>>(createQueue<T>(queueLength), queueLength, name);
+#else
+                    (void)name;
+                    return createQueue<T>(queueLength);
+#endif
+                }
+
                 // Factoría de Mutex
                 static std::unique_ptr<Core::OSAL::IMutex> createMutex()
                 {
                     return std::make_unique<OSAL::WinMutex>();
                 }
 
+                static std::unique_ptr<Core::OSAL::IMutex> createMutex(const char *name)
+                {
+#if defined(FP_ENABLE_CONTENTION_STATS)
+                    return std::make_unique<Core::OSAL::InstrumentedMutex>(createMutex(), name);
+#else
+                    (void)name;
+                    return createMutex();
+#endif
+                }
+
+                // Factoría de Flags de eventos
+                static std::unique_ptr<Core::OSAL::IEventFlags> createEventFlags()
+                {
+                    return std::make_unique<OSAL::WinEventFlags>();
+                }
+
+                // Factoría de Pools de bloques fijos
+                static std::unique_ptr<Core::OSAL::IBlockPool> createBlockPool(size_t blockSize, size_t blockCount)
+                {
+                    return std::make_unique<Core::Utils::FixedBlockPool>(blockSize, blockCount,
+                                                                         &allocPoolStorage, &freePoolStorage);
+                }
+
                 // sleep
                 static void sleep(uint32_t ms)
                 {
                     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
                 }
 
+                // Núcleos lógicos del PC (1 si no se sabe)
+                static size_t getCoreCount()
+                {
+                    unsigned cores = std::thread::hardware_concurrency();
+                    return cores ? cores : 1;
+                }
+
                 // Get current ms time
                 static uint64_t getSystemTimeMs()
                 {
@@ -46,6 +106,32 @@ namespace FlightProxy
                     auto duration = now.time_since_epoch();
                     return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
                 }
+
+                // Tiempo monótono en microsegundos. En Windows steady_clock ya es
+                // QueryPerformanceCounter; en Linux usamos CLOCK_MONOTONIC_RAW, que no
+                // lo corrige NTP y no da saltos al medir latencias.
+                static uint64_t getMonotonicTimeUs()
+                {
+#if defined(__linux__)
+                    struct timespec ts;
+                    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+                    return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
+#else
+                    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+                    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+#endif
+                }
+
+            private:
+                static void *allocPoolStorage(size_t bytes)
+                {
+                    return ::operator new(bytes, std::align_val_t(alignof(std::max_align_t)), std::nothrow);
+                }
+
+                static void freePoolStorage(void *storage)
+                {
+                    ::operator delete(storage, std::align_val_t(alignof(std::max_align_t)));
+                }
             };
         }
     }
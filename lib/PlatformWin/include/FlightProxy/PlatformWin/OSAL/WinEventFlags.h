@@ -0,0 +1,77 @@
+#pragma once
+#include "FlightProxy/Core/OSAL/IEventFlags.h"
+#include "FlightProxy/Core/OSAL/TaskRegistry.h"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace FlightProxy
+{
+    namespace PlatformWin
+    {
+        namespace OSAL
+        {
+            class WinEventFlags : public FlightProxy::Core::OSAL::IEventFlags
+            {
+            public:
+                WinEventFlags() = default;
+                virtual ~WinEventFlags() = default;
+
+                void set(Bits bits) override
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        bits_ |= bits;
+                        setAt_ = std::chrono::steady_clock::now();
+                    }
+                    changed_.notify_all(); // Puede haber esperas con máscaras distintas
+                }
+
+                void clear(Bits bits) override
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    bits_ &= ~bits;
+                }
+
+                Bits get() const override
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return bits_;
+                }
+
+                Bits wait(Bits bits, bool waitAll, bool clearOnExit, uint32_t timeout_ms) override
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    auto satisfied = [this, bits, waitAll]()
+                    {
+                        return waitAll ? (bits_ & bits) == bits : (bits_ & bits) != 0;
+                    };
+
+                    bool blocked = !satisfied();
+                    if (!changed_.wait_for(lock, std::chrono::milliseconds(timeout_ms), satisfied))
+                    {
+                        return bits_; // Timeout
+                    }
+                    if (blocked)
+                    {
+                        // Latencia de despertar: desde el set() hasta que este hilo corre
+                        auto latency = std::chrono::steady_clock::now() - setAt_;
+                        Core::OSAL::TaskRegistry::noteWake(static_cast<uint32_t>(
+                            std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+                    }
+
+                    Bits current = bits_;
+                    if (clearOnExit)
+                        bits_ &= ~bits;
+                    return current;
+                }
+
+            private:
+                mutable std::mutex mutex_;
+                std::condition_variable changed_;
+                Bits bits_ = 0;
+                std::chrono::steady_clock::time_point setAt_; // Último set()
+            };
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <utility>
 
 namespace FlightProxy
 {
@@ -18,7 +19,9 @@ namespace FlightProxy
                 WinQueue(uint32_t queueLength) : max_size_(queueLength) {}
                 virtual ~WinQueue() {}
 
-                bool send(const T &item, uint32_t timeout_ms) override
+                using FlightProxy::Core::OSAL::IQueue<T>::send;
+
+                bool send(T &&item, uint32_t timeout_ms) override
                 {
                     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -29,7 +32,7 @@ namespace FlightProxy
                         return false; // Timeout
                     }
 
-                    queue_.push(item);
+                    queue_.push(std::move(item));
                     not_empty_.notify_one(); // Avisar a un posible receptor
                     return true;
                 }
@@ -45,12 +48,56 @@ namespace FlightProxy
                         return false; // Timeout
                     }
 
-                    item = queue_.front();
+                    item = std::move(queue_.front());
                     queue_.pop();
                     not_full_.notify_one(); // Avisar a un posible emisor
                     return true;
                 }
 
+                // Todo el lote con un solo lock
+                size_t sendN(T *items, size_t count, uint32_t timeout_ms) override
+                {
+                    if (count == 0)
+                        return 0;
+
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (!not_full_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]()
+                                            { return queue_.size() < max_size_; }))
+                    {
+                        return 0; // Timeout
+                    }
+
+                    size_t sent = 0;
+                    while (sent < count && queue_.size() < max_size_)
+                    {
+                        queue_.push(std::move(items[sent++]));
+                    }
+                    not_empty_.notify_all();
+                    return sent;
+                }
+
+                size_t receiveN(T *items, size_t maxItems, uint32_t timeout_ms) override
+                {
+                    if (maxItems == 0)
+                        return 0;
+
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (!not_empty_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]()
+                                             { return !queue_.empty(); }))
+                    {
+                        return 0; // Timeout
+                    }
+
+                    size_t received = 0;
+                    while (received < maxItems && !queue_.empty())
+                    {
+                        items[received++] = std::move(queue_.front());
+                        queue_.pop();
+                    }
+                    not_full_.notify_all();
+                    return received;
+                }
+
             private:
                 std::queue<T> queue_;
                 const uint32_t max_size_;
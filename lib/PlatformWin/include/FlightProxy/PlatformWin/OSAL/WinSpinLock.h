@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+namespace FlightProxy
+{
+    namespace PlatformWin
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Spinlock para secciones críticas muy cortas.
+             *
+             * Test-and-test-and-set: mientras está ocupado solo lee (sin ensuciar la
+             * línea de caché) y tras unas vueltas cede el hilo, porque en el PC el
+             * dueño puede haber sido expulsado por el planificador.
+             */
+            class WinSpinLock
+            {
+            public:
+                WinSpinLock() = default;
+
+                WinSpinLock(const WinSpinLock &) = delete;
+                WinSpinLock &operator=(const WinSpinLock &) = delete;
+
+                void lock()
+                {
+                    for (;;)
+                    {
+                        if (!locked_.exchange(true, std::memory_order_acquire))
+                            return;
+                        int spins = 0;
+                        while (locked_.load(std::memory_order_relaxed))
+                        {
+                            if (++spins >= kSpinsBeforeYield)
+                            {
+                                std::this_thread::yield();
+                                spins = 0;
+                            }
+                        }
+                    }
+                }
+
+                bool try_lock()
+                {
+                    return !locked_.load(std::memory_order_relaxed) &&
+                           !locked_.exchange(true, std::memory_order_acquire);
+                }
+
+                void unlock() { locked_.store(false, std::memory_order_release); }
+
+            private:
+                static constexpr int kSpinsBeforeYield = 64;
+
+                std::atomic<bool> locked_{false};
+            };
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "FlightProxy/Core/OSAL/ITask.h"
+#include "WinTaskProbe.h"
 #include <thread>
 #include <atomic>
 #include <windows.h> // Necesario para HANDLE, SetThreadPriority, etc.
@@ -36,6 +37,7 @@ namespace FlightProxy
                     // Lanzamos el hilo
                     m_thread = std::thread([this]()
                                            {
+                        auto registration = registerCurrentTask(m_config);
                         if (m_userFunc)
                         {
                             m_userFunc();
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "FlightProxy/Core/OSAL/TaskRegistry.h"
+
+#include <chrono>
+#include <memory>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace FlightProxy
+{
+    namespace PlatformWin
+    {
+        namespace OSAL
+        {
+            /**
+             * @brief Contadores de un hilo del PC.
+             *
+             * Windows: tiempo de CPU con GetThreadTimes (sin cambios de contexto).
+             * Linux: tiempo de CPU con el reloj del hilo y cambios de contexto
+             * (voluntarios + involuntarios) de /proc/self/task/<tid>/status.
+             * La pila del PC no se mide (los hilos tienen megas).
+             */
+            class WinTaskProbe : public Core::OSAL::ITaskProbe
+            {
+            public:
+                // Se crea en el propio hilo
+                WinTaskProbe()
+                {
+#if defined(_WIN32)
+                    DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(),
+                                    &thread_, THREAD_QUERY_LIMITED_INFORMATION, FALSE, 0);
+#elif defined(__linux__)
+                    tid_ = static_cast<long>(syscall(SYS_gettid));
+                    hasClock_ = pthread_getcpuclockid(pthread_self(), &cpuClock_) == 0;
+#endif
+                }
+
+                ~WinTaskProbe() override
+                {
+#if defined(_WIN32)
+                    if (thread_)
+                        CloseHandle(thread_);
+#endif
+                }
+
+                WinTaskProbe(const WinTaskProbe &) = delete;
+                WinTaskProbe &operator=(const WinTaskProbe &) = delete;
+
+                bool read(Core::OSAL::TaskCounters &counters) override
+                {
+#if defined(_WIN32)
+                    FILETIME creation, exit, kernel, user;
+                    if (!thread_ || !GetThreadTimes(thread_, &creation, &exit, &kernel, &user))
+                        return false;
+                    // Unidades de 100 ns en los dos contadores
+                    counters.runTime = toU64(kernel) + toU64(user);
+                    counters.timeBase = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count() /
+                        100);
+                    counters.hasRunTime = true;
+                    return true;
+#elif defined(__linux__)
+                    struct timespec cpu, now;
+                    if (!hasClock_ || clock_gettime(cpuClock_, &cpu) != 0)
+                        return false; // El hilo ya terminó
+                    clock_gettime(CLOCK_MONOTONIC, &now);
+                    counters.runTime = toNs(cpu);
+                    counters.timeBase = toNs(now);
+                    counters.hasRunTime = true;
+                    counters.hasContextSwitches = readContextSwitches(counters.contextSwitches);
+                    return true;
+#else
+                    (void)counters;
+                    return false;
+#endif
+                }
+
+            private:
+#if defined(_WIN32)
+                static uint64_t toU64(const FILETIME &ft)
+                {
+                    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+                }
+
+                HANDLE thread_ = nullptr;
+#elif defined(__linux__)
+                static uint64_t toNs(const struct timespec &ts)
+                {
+                    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+                }
+
+                bool readContextSwitches(uint64_t &total) const
+                {
+                    char path[64];
+                    snprintf(path, sizeof(path), "/proc/self/task/%ld/status", tid_);
+                    FILE *file = fopen(path, "r");
+                    if (!file)
+                        return false;
+
+                    char line[128];
+                    unsigned long long value;
+                    int found = 0;
+                    total = 0;
+                    while (fgets(line, sizeof(line), file))
+                    {
+                        if (sscanf(line, "voluntary_ctxt_switches: %llu", &value) == 1 ||
+                            sscanf(line, "nonvoluntary_ctxt_switches: %llu", &value) == 1)
+                        {
+                            total += value;
+                            found++;
+                        }
+                    }
+                    fclose(file);
+                    return found == 2;
+                }
+
+                long tid_ = 0;
+                clockid_t cpuClock_{};
+                bool hasClock_ = false;
+#endif
+            };
+
+            // Alta del hilo actual en el registro (para hilos creados con std::thread)
+            inline std::unique_ptr<Core::OSAL::TaskRegistry::Registration> registerCurrentTask(const Core::OSAL::TaskConfig &config)
+            {
+                return std::make_unique<Core::OSAL::TaskRegistry::Registration>(config, std::make_unique<WinTaskProbe>());
+            }
+        }
+    }
+}
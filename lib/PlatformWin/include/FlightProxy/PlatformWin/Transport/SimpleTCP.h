@@ -1,5 +1,6 @@
 #pragma once
 #include "FlightProxy/Core/Transport/ITransport.h"
+#include "FlightProxy/Core/Transport/AsyncTxQueue.h"
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <thread>
@@ -21,15 +22,25 @@ namespace FlightProxy
                               public std::enable_shared_from_this<SimpleTCP>
             {
             public:
-                SimpleTCP(SOCKET accepted_socket);
-                SimpleTCP(const char *ip, uint16_t port);
+                SimpleTCP(SOCKET accepted_socket, const Core::Transport::AsyncTxConfig &txConfig = Core::Transport::AsyncTxConfig());
+                SimpleTCP(const char *ip, uint16_t port, const Core::Transport::AsyncTxConfig &txConfig = Core::Transport::AsyncTxConfig());
                 ~SimpleTCP() override;
 
                 void open() override;
                 void close() override;
+
+                // Todos encolan y vuelven: el ::send bloqueante lo hace el hilo de TX
                 void send(const uint8_t *data, size_t len) override;
+                bool trySend(const uint8_t *data, size_t len) override;
+                bool trySendFrame(const Core::Utils::ByteView &frame) override;
+                void sendv(const Core::Transport::IoSlice *slices, size_t count) override;
+                bool trySendv(const Core::Transport::IoSlice *slices, size_t count) override;
+                size_t pendingTxBytes() const override;
 
             private:
+                static constexpr size_t kMaxTxBatch = 8; // Tramas por llamada a WSASend
+                static constexpr size_t kRxChunkCount = Core::Utils::RxChunkPool::kDefaultChunkCount; // Bloques de recepción en el pool
+
                 SOCKET m_sock = INVALID_SOCKET;
                 uint16_t port_ = 0;
                 char ip_[16] = {0};
@@ -37,7 +48,13 @@ namespace FlightProxy
                 std::recursive_mutex mutex_;
                 std::atomic<bool> isRunning_{false}; // Para controlar el bucle del hilo de forma limpia
 
+                Core::Transport::AsyncTxQueue txQueue_;
+                std::thread txThread_;
+
                 void eventThreadFunc(); // Función miembro para el hilo
+                void txThreadFunc();    // Único hilo que escribe en el socket
+                void bindTxCallbacks();
+                bool isOpenForTx();
 
                 // Ayuda para inicializar Winsock solo una vez si es necesario
                 static void initWinsock();
@@ -1,5 +1,6 @@
 #pragma once
 #include "FlightProxy/Core/Transport/ITransport.h"
+#include "FlightProxy/Core/OSAL/Locks.h"
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <thread>
@@ -26,15 +27,23 @@ namespace FlightProxy
                 void open() override;
                 void close() override;
                 void send(const uint8_t *data, size_t len) override;
+                void sendv(const Core::Transport::IoSlice *slices, size_t count) override;
 
             private:
+                static constexpr size_t kMaxSlices = 8; // Trozos por datagrama en sendv()
+                static constexpr size_t kRxChunkCount = Core::Utils::RxChunkPool::kDefaultChunkCount; // Bloques de recepción en el pool
+
                 SOCKET m_sock = INVALID_SOCKET;
                 uint16_t m_port;
 
-                // Para responder al último remitente
+                // Para responder al último remitente (lo actualiza la RX en cada datagrama;
+                // spinlock propio para no esperar a un send() que tenga mutex_)
                 struct sockaddr_in m_last_sender_addr;
                 int m_last_sender_len;
                 bool m_has_last_sender = false;
+                Core::OSAL::SpinLock senderLock_;
+
+                bool lastSender(struct sockaddr_in &addr, int &len);
 
                 std::recursive_mutex mutex_;
                 std::atomic<bool> isRunning_{false};
@@ -1,6 +1,7 @@
 #include "FlightProxy/PlatformWin/Transport/ListenerTCP.h"
 #include "FlightProxy/PlatformWin/Transport/SimpleTCP.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformWin/OSAL/WinTaskProbe.h"
 #include <iostream>
 
 namespace FlightProxy
@@ -143,6 +144,7 @@ namespace FlightProxy
 
             void ListenerTCP::listenerThreadFunc()
             {
+                auto registration = OSAL::registerCurrentTask({"tcp_listener", 0, 5, -1});
                 FP_LOG_I(TAG, "Hilo de Listener iniciado.");
 
                 while (m_is_running.load())
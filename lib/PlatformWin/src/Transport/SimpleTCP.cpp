@@ -1,5 +1,6 @@
 #include "FlightProxy/PlatformWin/Transport/SimpleTCP.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformWin/OSAL/WinTaskProbe.h"
 #include <cstring>
 #include <iostream>
 
@@ -40,17 +41,19 @@ namespace FlightProxy
                 }
             }
 
-            SimpleTCP::SimpleTCP(SOCKET accepted_socket)
-                : m_sock(accepted_socket), port_(0)
+            SimpleTCP::SimpleTCP(SOCKET accepted_socket, const Core::Transport::AsyncTxConfig &txConfig)
+                : m_sock(accepted_socket), port_(0), txQueue_(txConfig)
             {
                 initWinsock();
                 ip_[0] = '\0';
+                bindTxCallbacks();
             }
 
-            SimpleTCP::SimpleTCP(const char *ip, uint16_t port)
-                : m_sock(INVALID_SOCKET), port_(port)
+            SimpleTCP::SimpleTCP(const char *ip, uint16_t port, const Core::Transport::AsyncTxConfig &txConfig)
+                : m_sock(INVALID_SOCKET), port_(port), txQueue_(txConfig)
             {
                 initWinsock();
+                bindTxCallbacks();
                 if (ip != nullptr)
                 {
                     strncpy_s(ip_, sizeof(ip_), ip, _TRUNCATE);
@@ -65,10 +68,34 @@ namespace FlightProxy
             SimpleTCP::~SimpleTCP()
             {
                 close(); // Asegurar cierre
+                txQueue_.close();
+                if (txThread_.joinable())
+                {
+                    if (txThread_.get_id() == std::this_thread::get_id())
+                        txThread_.detach(); // Nos destruye el propio hilo de TX al soltar su referencia
+                    else
+                        txThread_.join();
+                }
                 cleanupWinsock();
                 FP_LOG_I(TAG, "Canal destruido.");
             }
 
+            void SimpleTCP::bindTxCallbacks()
+            {
+                // Las marcas de la cola de TX se reflejan en los callbacks del transporte
+                txQueue_.onHigh = [this]()
+                {
+                    FP_LOG_W(TAG, "Cola de TX por encima de la marca alta (%zu bytes)", txQueue_.pendingBytes());
+                    if (onBackpressure)
+                        onBackpressure();
+                };
+                txQueue_.onLow = [this]()
+                {
+                    if (onWritable)
+                        onWritable();
+                };
+            }
+
             void SimpleTCP::open()
             {
                 std::lock_guard lock(mutex_);
@@ -126,10 +153,16 @@ namespace FlightProxy
                     m_sock = sock;
                 }
 
-                // --- Iniciar hilo de lectura ---
+                // --- Iniciar hilos de escritura y lectura ---
                 isRunning_.store(true);
                 try
                 {
+                    if (txThread_.joinable())
+                        txThread_.join(); // El de una conexión anterior ya terminó
+                    txQueue_.reopen();
+                    txThread_ = std::thread([self = shared_from_this()]()
+                                            { self->txThreadFunc(); });
+
                     std::thread([self = shared_from_this()]()
                                 { self->eventThreadFunc(); })
                         .detach();
@@ -137,6 +170,7 @@ namespace FlightProxy
                 catch (...)
                 {
                     isRunning_.store(false);
+                    txQueue_.close();
                     if (m_sock != INVALID_SOCKET)
                     {
                         closesocket(m_sock);
@@ -166,29 +200,124 @@ namespace FlightProxy
             }
 
             void SimpleTCP::send(const uint8_t *data, size_t len)
+            {
+                if (!trySend(data, len))
+                {
+                    FP_LOG_W(TAG, "Cola de TX llena o cerrada, %zu bytes descartados.", len);
+                }
+            }
+
+            bool SimpleTCP::trySend(const uint8_t *data, size_t len)
+            {
+                if (!isOpenForTx() || !data || len == 0)
+                    return false;
+
+                // Solo copia a la cola; nunca espera al socket
+                return txQueue_.push(data, len);
+            }
+
+            bool SimpleTCP::trySendFrame(const Core::Utils::ByteView &frame)
+            {
+                if (!isOpenForTx())
+                    return false;
+
+                // La cola comparte la trama (sin copia); se libera cuando sale por el socket
+                return txQueue_.pushFrame(frame);
+            }
+
+            void SimpleTCP::sendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                if (!trySendv(slices, count))
+                {
+                    FP_LOG_W(TAG, "Cola de TX llena o cerrada, trama de %zu trozos descartada.", count);
+                }
+            }
+
+            bool SimpleTCP::trySendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                if (!isOpenForTx())
+                    return false;
+
+                // Los trozos se copian una vez, directamente a un bloque reservado de la cola
+                return txQueue_.pushv(slices, count);
+            }
+
+            bool SimpleTCP::isOpenForTx()
             {
                 std::lock_guard lock(mutex_);
-                if (m_sock == INVALID_SOCKET)
-                    return;
-                if (!data || len == 0)
-                    return;
+                return m_sock != INVALID_SOCKET;
+            }
 
-                size_t total_sent = 0;
-                while (total_sent < len)
+            size_t SimpleTCP::pendingTxBytes() const
+            {
+                return txQueue_.pendingBytes();
+            }
+
+            void SimpleTCP::txThreadFunc()
+            {
+                auto registration = OSAL::registerCurrentTask({"tcp_tx", 0, 5, -1});
+                std::vector<Core::Utils::ByteView> batch;
+                WSABUF buffers[kMaxTxBatch];
+                while (true)
                 {
-                    int sent_now = ::send(m_sock, (const char *)(data + total_sent), (int)(len - total_sent), 0);
-                    if (sent_now == SOCKET_ERROR)
+                    if (txQueue_.popBatch(batch, kMaxTxBatch, 1000) == 0)
                     {
-                        FP_LOG_E(TAG, "Error en send(): %d", WSAGetLastError());
-                        shutdown(m_sock, SD_BOTH);
-                        return;
+                        if (txQueue_.isClosed())
+                            break;
+                        continue;
+                    }
+
+                    SOCKET sock;
+                    {
+                        std::lock_guard lock(mutex_);
+                        sock = m_sock;
+                    }
+
+                    size_t batch_bytes = 0;
+                    for (size_t i = 0; i < batch.size(); ++i)
+                    {
+                        buffers[i].buf = reinterpret_cast<CHAR *>(const_cast<uint8_t *>(batch[i].data()));
+                        buffers[i].len = static_cast<ULONG>(batch[i].size());
+                        batch_bytes += batch[i].size();
+                    }
+
+                    // Todo el lote en una llamada (WSASend). Sin el mutex: si el par va lento
+                    // solo se bloquea este hilo
+                    WSABUF *pending = buffers;
+                    DWORD pending_count = static_cast<DWORD>(batch.size());
+                    while (sock != INVALID_SOCKET && pending_count > 0)
+                    {
+                        DWORD sent_now = 0;
+                        if (WSASend(sock, pending, pending_count, &sent_now, 0, nullptr, nullptr) == SOCKET_ERROR)
+                        {
+                            FP_LOG_E(TAG, "Error en WSASend(): %d", WSAGetLastError());
+                            shutdown(sock, SD_BOTH);
+                            break;
+                        }
+
+                        // Envío parcial: saltamos los trozos completos y recortamos el siguiente
+                        DWORD advance = sent_now;
+                        while (pending_count > 0 && advance >= pending->len)
+                        {
+                            advance -= pending->len;
+                            pending++;
+                            pending_count--;
+                        }
+                        if (pending_count > 0)
+                        {
+                            pending->buf += advance;
+                            pending->len -= advance;
+                        }
                     }
-                    total_sent += sent_now;
+                    batch.clear(); // Suelta las tramas (y sus bloques) antes de avisar de la marca baja
+                    txQueue_.done(batch_bytes);
                 }
+                FP_LOG_I(TAG, "Hilo de TX terminado.");
             }
 
             void SimpleTCP::eventThreadFunc()
             {
+                auto registration = OSAL::registerCurrentTask({"tcp_event", 0, 5, -1});
                 // Mantenemos una referencia shared_ptr a nosotros mismos para evitar destrucción prematura
                 // (Esto ya se pasa implícitamente si usas std::bind o lambdas que capturan shared_ptr,
                 //  pero aquí lo hicimos pasando shared_from_this() al constructor del thread)
@@ -197,16 +326,17 @@ namespace FlightProxy
                     onOpen();
 
                 FP_LOG_I(TAG, "Hilo iniciado.");
-                std::vector<char> rx_buffer(4096);
+                // Bloques reutilizables: los paquetes decodificados pueden apuntar a ellos
+                Core::Utils::RxChunkPool rx_pool(4096, kRxChunkCount);
 
                 while (isRunning_.load())
                 {
-                    int len = recv(m_sock, rx_buffer.data(), (int)rx_buffer.size(), 0);
+                    std::shared_ptr<Core::Utils::RxChunk> chunk = rx_pool.acquire();
+                    int len = recv(m_sock, reinterpret_cast<char *>(chunk->bytes.data()), (int)chunk->bytes.size(), 0);
                     if (len > 0)
                     {
                         // FP_LOG_I(TAG, "Datos recibidos: %d bytes.", len);
-                        if (onData)
-                            onData((uint8_t *)rx_buffer.data(), len);
+                        deliverRx(chunk, len);
                     }
                     else if (len == 0)
                     {
@@ -220,16 +350,23 @@ namespace FlightProxy
                 }
 
                 // Limpieza
+                SOCKET sock_to_close = INVALID_SOCKET;
                 {
                     std::lock_guard lock(mutex_);
-                    if (m_sock != INVALID_SOCKET)
-                    {
-                        closesocket(m_sock);
-                        m_sock = INVALID_SOCKET;
-                    }
+                    sock_to_close = m_sock;
+                    m_sock = INVALID_SOCKET;
                     isRunning_.store(false);
                 }
 
+                // Paramos el hilo de TX antes de cerrar el socket que aún puede estar usando
+                if (sock_to_close != INVALID_SOCKET)
+                    shutdown(sock_to_close, SD_BOTH);
+                txQueue_.close();
+                if (txThread_.joinable())
+                    txThread_.join();
+                if (sock_to_close != INVALID_SOCKET)
+                    closesocket(sock_to_close);
+
                 if (onClose)
                     onClose();
                 FP_LOG_I(TAG, "Hilo terminado.");
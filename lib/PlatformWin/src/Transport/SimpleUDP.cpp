@@ -1,5 +1,6 @@
 #include "FlightProxy/PlatformWin/Transport/SimpleUDP.h"
 #include "FlightProxy/Core/Utils/Logger.h"
+#include "FlightProxy/PlatformWin/OSAL/WinTaskProbe.h"
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -127,11 +128,13 @@ namespace FlightProxy
             void SimpleUDP::send(const uint8_t *data, size_t len)
             {
                 std::lock_guard lock(mutex_);
-                if (m_sock == INVALID_SOCKET || !m_has_last_sender || !data || len == 0)
+                struct sockaddr_in dest;
+                int dest_len;
+                if (m_sock == INVALID_SOCKET || !lastSender(dest, dest_len) || !data || len == 0)
                     return;
 
                 int sent = sendto(m_sock, (const char *)data, (int)len, 0,
-                                  (struct sockaddr *)&m_last_sender_addr, m_last_sender_len);
+                                  (struct sockaddr *)&dest, dest_len);
 
                 if (sent == SOCKET_ERROR)
                 {
@@ -139,39 +142,72 @@ namespace FlightProxy
                 }
             }
 
+            void SimpleUDP::sendv(const Core::Transport::IoSlice *slices, size_t count)
+            {
+                std::lock_guard lock(mutex_);
+                struct sockaddr_in dest;
+                int dest_len;
+                if (m_sock == INVALID_SOCKET || !lastSender(dest, dest_len) || count == 0 || count > kMaxSlices)
+                    return;
+
+                // Un solo datagrama con todos los trozos (WSASendTo), sin aplanarlos antes
+                WSABUF buffers[kMaxSlices];
+                for (size_t i = 0; i < count; ++i)
+                {
+                    buffers[i].buf = reinterpret_cast<CHAR *>(const_cast<uint8_t *>(slices[i].data));
+                    buffers[i].len = static_cast<ULONG>(slices[i].len);
+                }
+
+                DWORD sent = 0;
+                if (WSASendTo(m_sock, buffers, static_cast<DWORD>(count), &sent, 0,
+                              (struct sockaddr *)&dest, dest_len,
+                              nullptr, nullptr) == SOCKET_ERROR)
+                {
+                    FP_LOG_E(TAG, "Error WSASendTo UDP: %d", WSAGetLastError());
+                }
+            }
+
+            bool SimpleUDP::lastSender(struct sockaddr_in &addr, int &len)
+            {
+                std::lock_guard lock(senderLock_);
+                addr = m_last_sender_addr;
+                len = m_last_sender_len;
+                return m_has_last_sender;
+            }
+
             void SimpleUDP::eventThreadFunc()
             {
+                auto registration = OSAL::registerCurrentTask({"udp_event", 0, 5, -1});
                 if (onOpen)
                     onOpen();
 
                 FP_LOG_I(TAG, "Hilo UDP iniciado.");
-                std::vector<char> rx_buffer(1500); // MTU típica
+                // MTU típica. Bloques reutilizables: los paquetes decodificados pueden apuntar a ellos
+                Core::Utils::RxChunkPool rx_pool(1500, kRxChunkCount);
 
                 while (isRunning_.load())
                 {
                     struct sockaddr_in sender_addr;
                     int sender_len = sizeof(sender_addr);
 
-                    int len = recvfrom(m_sock, rx_buffer.data(), (int)rx_buffer.size(), 0,
+                    std::shared_ptr<Core::Utils::RxChunk> chunk = rx_pool.acquire();
+                    int len = recvfrom(m_sock, reinterpret_cast<char *>(chunk->bytes.data()), (int)chunk->bytes.size(), 0,
                                        (struct sockaddr *)&sender_addr, &sender_len);
 
                     if (len > 0)
                     {
                         {
-                            std::lock_guard lock(mutex_);
+                            std::lock_guard lock(senderLock_);
                             m_last_sender_addr = sender_addr;
                             m_last_sender_len = sender_len;
                             m_has_last_sender = true;
                         }
 
-                        if (onData)
-                        {
-                            // Opcional: log de IP remitente
-                            // char ip_str[INET_ADDRSTRLEN];
-                            // inet_ntop(AF_INET, &sender_addr.sin_addr, ip_str, INET_ADDRSTRLEN);
-                            // FP_LOG_I(TAG, "UDP de %s:%u", ip_str, ntohs(sender_addr.sin_port));
-                            onData((uint8_t *)rx_buffer.data(), len);
-                        }
+                        // Opcional: log de IP remitente
+                        // char ip_str[INET_ADDRSTRLEN];
+                        // inet_ntop(AF_INET, &sender_addr.sin_addr, ip_str, INET_ADDRSTRLEN);
+                        // FP_LOG_I(TAG, "UDP de %s:%u", ip_str, ntohs(sender_addr.sin_port));
+                        deliverRx(chunk, len);
                     }
                     else
                     {
@@ -191,9 +227,12 @@ namespace FlightProxy
                         closesocket(m_sock);
                         m_sock = INVALID_SOCKET;
                     }
-                    m_has_last_sender = false;
                     isRunning_.store(false);
                 }
+                {
+                    std::lock_guard lock(senderLock_);
+                    m_has_last_sender = false;
+                }
 
                 if (onClose)
                     onClose();
@@ -10,6 +10,11 @@ static FlightProxy::PlatformWin::Utils::HostLogger logger;
 
 // incluimos fabrica de osal
 #include "FlightProxy/Core/OSAL/OSALFactory.h"
+#include "FlightProxy/Core/OSAL/TimerService.h"
+#include "FlightProxy/Core/OSAL/WorkStealingExecutor.h"
+#include "FlightProxy/Core/OSAL/TaskRegistry.h"
+#include "FlightProxy/Core/OSAL/ContentionStats.h"
+#include "FlightProxy/Core/Utils/Profiler.h"
 
 // incluimos fabrica de transportes
 #include "FlightProxy/Core/Transport/TransportFactory.h"
@@ -32,15 +37,19 @@ static FlightProxy::PlatformWin::Utils::HostLogger logger;
 #include "FlightProxy/Channel/ChannelServer.h"
 #include "FlightProxy/Channel/ChannelAgregatorT.h"
 #include "FlightProxy/Channel/ChannelDisgregatorT.h"
+#include "FlightProxy/Channel/ChannelPrioritizedT.h"
+#include "FlightProxy/Channel/ChannelConflatingT.h"
 
 // App Logic - Command Manager
 #include "FlightProxy/AppLogic/Command/CommandManager.h"
 #include "FlightProxy/AppLogic/Command/Commands/MSP_BasicRead_Command.h"
 #include "FlightProxy/AppLogic/Command/Commands/MSP_ReadRCblackboard.h"
+#include "FlightProxy/AppLogic/Command/Commands/MSP_Passthrough.h"
 
 // App Logic - Data Nodes
 #include "FlightProxy/AppLogic/DataNode/DataNodesManagerT.h"
 #include "FlightProxy/AppLogic/DataNode/DataNodes/Nodo_Recepcion_IMU.h"
+#include "FlightProxy/AppLogic/DataNode/DataNodes/Nodo_Recepcion_IMU_Co.h"
 #include "FlightProxy/AppLogic/DataNode/DataNodes/Nodo_Recepcion_Status.h"
 #include "FlightProxy/AppLogic/DataNode/DataNodes/Nodo_Emision_RC.h"
 
@@ -51,6 +60,10 @@ void app()
 
     FP_LOG_I("main", "Logger inicializado.");
 
+    // Pool de paquetes MSP: new/delete O(1) y sin fragmentar el heap durante el vuelo
+    FlightProxy::Core::MspPacket::setAllocationPool(
+        FlightProxy::Core::OSAL::Factory::createBlockPool(sizeof(FlightProxy::Core::MspPacket), 64));
+
     // Almacen flexible init
     enum DataIDs : FlightProxy::AppLogic::DataID
     {
@@ -101,7 +114,8 @@ void app()
     // Servidor TCP
     auto decoder_factory = []() -> std::shared_ptr<FlightProxy::Core::Protocol::IDecoderT<Packet>>
     {
-        return std::make_shared<FlightProxy::Core::Protocol::MspDecoder>();
+        // Conserva la trama original para reenviarla a la FC sin recodificar
+        return std::make_shared<FlightProxy::Core::Protocol::MspDecoder>(true);
     };
     auto encoder_factory = []() -> std::shared_ptr<FlightProxy::Core::Protocol::IEncoderT<Packet>>
     {
@@ -114,29 +128,66 @@ void app()
     auto tcp_server = std::make_shared<FlightProxy::Channel::ChannelServer<Packet>>(decoder_factory, encoder_factory, listener_factory);
 
     auto agregadorTcpClients = std::make_shared<FlightProxy::Channel::ChannelAgregatorT<Packet>>();
+    agregadorTcpClients->setBroadcastEncoder(encoder_factory());
 
     tcp_server->onNewChannel = [agregadorTcpClients](std::shared_ptr<FlightProxy::Core::Channel::IChannelT<Packet>> channel)
     {
-        agregadorTcpClients->addChannel(channel);
+        // Telemetría hacia el GCS: con el socket congestionado solo queda pendiente la
+        // respuesta más reciente de IMU y estado (el resto sale en orden)
+        auto conflated = std::make_shared<FlightProxy::Channel::ChannelConflatingT<Packet>>(
+            channel,
+            [](const Packet &pkt) -> uint32_t
+            { return pkt.command; },
+            std::vector<uint32_t>{FlightProxy::Core::Protocol::MSP_IMU_DATA,
+                                  FlightProxy::Core::Protocol::MSP_STATUS_DATA});
+        agregadorTcpClients->addChannel(conflated);
     };
 
     tcp_server->start(12345);
 
+    // Temporizadores compartidos: timeouts de comandos y periodos de los DataNodes
+    auto timerService = std::make_shared<FlightProxy::Core::OSAL::TimerService>();
+    timerService->start();
+
+    // Estadísticas de tareas (CPU, pila, latencia): una ventana cada 5 s
+    auto &taskRegistry = FlightProxy::Core::OSAL::TaskRegistry::instance();
+    timerService->schedulePeriodic(5000 * 1000, [&taskRegistry]()
+                                   { taskRegistry.sample(); });
+
+    FlightProxy::AppLogic::Command::CommandManagerConfig commandConfig;
+#if !defined(ESP_PLATFORM)
+    // En el PC comandos y DataNodes van a un executor con un worker por núcleo:
+    // el número de hilos ya no crece con los clientes ni con los nodos
+    auto executor = std::make_shared<FlightProxy::Core::OSAL::WorkStealingExecutor>();
+    executor->start();
+    commandConfig.workerCount = executor->workerCount(); // Un shard por worker
+#endif
+
     // Command Manager
-    auto commandManager = std::make_shared<FlightProxy::AppLogic::Command::CommandManager<Packet>>();
+    auto commandManager = std::make_shared<FlightProxy::AppLogic::Command::CommandManager<Packet>>(commandConfig);
+    commandManager->setTimerService(timerService);
+#if !defined(ESP_PLATFORM)
+    commandManager->setExecutor(executor);
+#endif
 
     // Conectamos agregator con command manager
     // Paquetes de ida
-    agregadorTcpClients->onPacketFromAnyChannel = [commandManager](const FlightProxy::Core::PacketEnvelope<Packet> &envelope)
+    agregadorTcpClients->onPacketFromAnyChannel = [commandManager](FlightProxy::Core::PacketEnvelope<Packet> &envelope)
     {
         return commandManager->enqueuePacket(envelope);
     };
+    agregadorTcpClients->start();
     // Paquetes de vuelta
     commandManager->responsehandler = [agregadorTcpClients](uint32_t channelId, std::unique_ptr<const Packet> packet) -> bool
     {
         agregadorTcpClients->response(channelId, std::move(packet));
         return true;
     };
+    // Respuesta de error MSP ('!') si un comando expira o se rechaza por saturación
+    commandManager->errorReplyFactory = [](int commandId) -> std::unique_ptr<const Packet>
+    {
+        return std::make_unique<const Packet>('!', static_cast<uint16_t>(commandId), std::vector<uint8_t>{});
+    };
 
     // Registrar los comandos
     auto commans1 = std::make_shared<FlightProxy::AppLogic::Command::Commands::MSP_BasicRead_Command<Packet>>();
@@ -148,8 +199,6 @@ void app()
 
     // commans1.reset();
 
-    commandManager->start();
-
     //________________________________________RC FLUX___________________________________________________________
 
     using Bus = FlightProxy::Core::IBUSPacket;
@@ -191,23 +240,70 @@ void app()
     // Cliente TCP hacia el dron
     auto msp_transport = FlightProxy::Core::Transport::Factory::CreateSimpleTCP("127.0.0.1", 5762);
     auto msp_transport_encoder = std::make_shared<FlightProxy::Core::Protocol::MspEncoder>();
-    auto msp_transport_decoder = std::make_shared<FlightProxy::Core::Protocol::MspDecoder>();
+    auto msp_transport_decoder = std::make_shared<FlightProxy::Core::Protocol::MspDecoder>(true);
 
     auto msp_client = std::make_shared<FlightProxy::Channel::ChannelT<Packet>>(msp_transport, msp_transport_encoder, msp_transport_decoder);
 
-    auto msp_client_channel = std::make_shared<FlightProxy::Channel::ChannelDisgregatorT<Packet>>(msp_client,
+    // Carriles de envío hacia la FC: 0 = RC, 1 = telemetría de los DataNodes, 2 = resto (passthrough)
+    FlightProxy::Channel::ChannelPrioritizedConfig fcTxConfig;
+    fcTxConfig.lanes[0].dropOldest = true; // De RC solo importa la trama más reciente
+    auto msp_client_tx = std::make_shared<FlightProxy::Channel::ChannelPrioritizedT<Packet>>(
+        msp_client,
+        [](const Packet &pkt) -> size_t
+        {
+            switch (pkt.command)
+            {
+            case FlightProxy::Core::Protocol::MSP_RC_DATA:
+                return 0;
+            case FlightProxy::Core::Protocol::MSP_IMU_DATA:
+            case FlightProxy::Core::Protocol::MSP_STATUS_DATA:
+                return 1;
+            default:
+                return 2;
+            }
+        },
+        fcTxConfig);
+
+    auto msp_client_channel = std::make_shared<FlightProxy::Channel::ChannelDisgregatorT<Packet>>(msp_client_tx,
                                                                                                   [](const Packet &pkt) -> FlightProxy::Channel::CommandId
                                                                                                   {
                                                                                                       return pkt.command;
                                                                                                   });
     msp_client->open();
+
+    // Passthrough: lo que no atiende un comando local se reenvía a la FC
+    auto mspPassthrough = std::make_shared<FlightProxy::AppLogic::Command::Commands::MSP_Passthrough<Packet>>(
+        msp_client_channel->createCatchAllChannel());
+    // Lecturas periódicas que varios GCS piden a la vez: una sola petición a la FC
+    mspPassthrough->setCollapsible(FlightProxy::Core::Protocol::MSP_IMU_DATA);
+    mspPassthrough->setCollapsible(FlightProxy::Core::Protocol::MSP_STATUS_DATA);
+    // Las respuestas que ya piden los DataNodes sirven a los GCS mientras estén frescas
+    mspPassthrough->setCacheTtl(FlightProxy::Core::Protocol::MSP_IMU_DATA, 500);
+    mspPassthrough->setCacheTtl(FlightProxy::Core::Protocol::MSP_STATUS_DATA, 1000);
+    commandManager->setFallbackCommand(mspPassthrough);
+
+    commandManager->start();
     //________________________________________Data Nodes___________________________________________________________
 
-    auto dataNodesManager = std::make_shared<FlightProxy::AppLogic::DataNode::DataNodesManager>();
+    auto dataNodesManager = std::make_shared<FlightProxy::AppLogic::DataNode::DataNodesManager>(timerService);
+#if !defined(ESP_PLATFORM)
+    dataNodesManager->setExecutor(executor);
+#endif
 
+#if FP_HAS_COROUTINES
+    // Con C++20 el nodo de la IMU usa co_await: petición y respuesta seguidas, con timeout
+    auto nodoRecepcionIMU = std::make_shared<FlightProxy::AppLogic::DataNode::DataNodes::Nodo_Recepcion_IMU_Co>(
+        msp_client_channel->createVirtualChannel(FlightProxy::Core::Protocol::MSP_IMU_DATA),
+        blackboard->registrarProductor<FlightProxy::Core::IMUData>(ID_IMU_Data),
+        timerService, 200);
+#if !defined(ESP_PLATFORM)
+    nodoRecepcionIMU->setExecutor(executor);
+#endif
+#else
     auto nodoRecepcionIMU = std::make_shared<FlightProxy::AppLogic::DataNode::DataNodes::Nodo_Recepcion_IMU>(
         msp_client_channel->createVirtualChannel(FlightProxy::Core::Protocol::MSP_IMU_DATA),
         blackboard->registrarProductor<FlightProxy::Core::IMUData>(ID_IMU_Data));
+#endif
     dataNodesManager->addDataNode(nodoRecepcionIMU, 500); // cada 500 ms
 
     auto nodoRecepcionStatus = std::make_shared<FlightProxy::AppLogic::DataNode::DataNodes::Nodo_Recepcion_Status>(
@@ -227,6 +323,7 @@ void app()
     auto getstatus = blackboard->registrarConsumidor<FlightProxy::Core::StatusData>(ID_STATUS_Data);
     auto getrc = blackboard->registrarConsumidor<FlightProxy::Core::RCData>(ID_RC_Input);
 
+    uint32_t loops = 0;
     while (true)
     {
         auto imu = getimu(); // actualiza el dato interno
@@ -245,6 +342,14 @@ void app()
                  rc_input.roll, rc_input.pitch, rc_input.throttle,
                  rc_input.yaw, rc_input.aux1, rc_input.aux2);
 
+        FP_PROFILE_DUMP(); // Solo con -DFP_ENABLE_PROFILING
+
+        if (++loops % 10 == 0)
+        {
+            taskRegistry.dump();
+            FP_CONTENTION_DUMP(); // Solo con -DFP_ENABLE_CONTENTION_STATS
+        }
+
         FlightProxy::Core::OSAL::Factory::sleep(1000);
     }
 }